@@ -345,4 +345,31 @@ namespace MMAP
 
         return queryItr->second;
     }
+
+    dtNavMeshQuery const* MMapManager::GetWorkerNavMeshQuery(uint32 mapId, uint32 workerSlot)
+    {
+        auto itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return nullptr;
+
+        MMapData* mmap = itr->second;
+        std::lock_guard<std::mutex> lock(workerQueriesLock);
+        auto [queryItr, inserted] = mmap->workerNavMeshQueries.try_emplace(workerSlot, nullptr);
+        if (!inserted)
+            return queryItr->second;
+
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        ASSERT(query);
+        if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
+        {
+            dtFreeNavMeshQuery(query);
+            mmap->workerNavMeshQueries.erase(queryItr);
+            TC_LOG_ERROR("maps", "MMAP:GetWorkerNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId {:03} worker {}", mapId, workerSlot);
+            return nullptr;
+        }
+
+        TC_LOG_DEBUG("maps", "MMAP:GetWorkerNavMeshQuery: created dtNavMeshQuery for mapId {:03} worker {}", mapId, workerSlot);
+        queryItr->second = query;
+        return query;
+    }
 }
@@ -21,6 +21,7 @@
 #include "Define.h"
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -40,12 +41,16 @@ namespace MMAP
             for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
                 dtFreeNavMeshQuery(i->second);
 
+            for (NavMeshQuerySet::iterator i = workerNavMeshQueries.begin(); i != workerNavMeshQueries.end(); ++i)
+                dtFreeNavMeshQuery(i->second);
+
             if (navMesh)
                 dtFreeNavMesh(navMesh);
         }
 
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
+        NavMeshQuerySet workerNavMeshQueries; // worker slot to query, for paths calculated off the map thread
 
         dtNavMesh* navMesh;
         MMapTileSet loadedTileRefs;        // maps [map grid coords] to [dtTile]
@@ -70,6 +75,9 @@ namespace MMAP
 
             // the returned [dtNavMeshQuery const*] is NOT threadsafe
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
+            // query owned by a worker thread slot, shared by all instances of the map
+            // the slot must only ever be used by one thread
+            dtNavMeshQuery const* GetWorkerNavMeshQuery(uint32 mapId, uint32 workerSlot);
             dtNavMesh const* GetNavMesh(uint32 mapId);
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
@@ -82,6 +90,7 @@ namespace MMAP
             MMapDataSet loadedMMaps;
             uint32 loadedTiles;
             bool thread_safe_environment;
+            std::mutex workerQueriesLock;
     };
 }
 
@@ -21,68 +21,50 @@
 
 #include "DBCFileLoader.h"
 #include "Errors.h"
+#include <boost/iostreams/device/mapped_file.hpp>
 
 DBCFileLoader::DBCFileLoader() : recordSize(0), recordCount(0), fieldCount(0), stringSize(0), fieldsOffset(nullptr), data(nullptr), stringTable(nullptr) { }
 
 bool DBCFileLoader::Load(char const* filename, char const* fmt)
 {
-    uint32 header;
-    if (data)
-    {
-        delete [] data;
-        data = nullptr;
-    }
+    data = nullptr;
+    stringTable = nullptr;
+    mapping.reset();
 
-    FILE* f = fopen(filename, "rb");
-    if (!f)
-        return false;
+    // private mapping: pages are shared with every process mapping the same file until one of them writes to a record
+    boost::iostreams::mapped_file_params params(filename);
+    params.flags = boost::iostreams::mapped_file::priv;
 
-    if (fread(&header, 4, 1, f) != 1)                        // Number of records
+    std::shared_ptr<boost::iostreams::mapped_file> file = std::make_shared<boost::iostreams::mapped_file>();
+    try
     {
-        fclose(f);
-        return false;
+        file->open(params);
     }
-
-    EndianConvert(header);
-
-    if (header != 0x43424457)                                //'WDBC'
+    catch (std::exception const&)
     {
-        fclose(f);
         return false;
     }
 
-    if (fread(&recordCount, 4, 1, f) != 1)                   // Number of records
-    {
-        fclose(f);
+    uint32 header[5];                                       // 'WDBC', records, fields, record size, string size
+    if (file->size() < sizeof(header))
         return false;
-    }
 
-    EndianConvert(recordCount);
+    memcpy(header, file->const_data(), sizeof(header));
+    for (uint32& value : header)
+        EndianConvert(value);
 
-    if (fread(&fieldCount, 4, 1, f) != 1)                    // Number of fields
-    {
-        fclose(f);
+    if (header[0] != 0x43424457)                            //'WDBC'
         return false;
-    }
 
-    EndianConvert(fieldCount);
+    recordCount = header[1];
+    fieldCount = header[2];
+    recordSize = header[3];
+    stringSize = header[4];
 
-    if (fread(&recordSize, 4, 1, f) != 1)                    // Size of a record
-    {
-        fclose(f);
+    if (file->size() - sizeof(header) < uint64(recordSize) * recordCount + stringSize)
         return false;
-    }
-
-    EndianConvert(recordSize);
-
-    if (fread(&stringSize, 4, 1, f) != 1)                    // String size
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(stringSize);
 
+    delete[] fieldsOffset;
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
     for (uint32 i = 1; i < fieldCount; ++i)
@@ -94,24 +76,15 @@ bool DBCFileLoader::Load(char const* filename, char const* fmt)
             fieldsOffset[i] += sizeof(uint32);
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
+    mapping = std::move(file);
+    data = reinterpret_cast<unsigned char*>(mapping->data()) + sizeof(header);
     stringTable = data + recordSize*recordCount;
 
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
-        return false;
-    }
-
-    fclose(f);
-
     return true;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    delete[] data;
-
     delete[] fieldsOffset;
 }
 
@@ -186,6 +159,7 @@ char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**
     //get struct size and index pos
     int32 i;
     uint32 recordsize = GetFormatRecordSize(format, &i);
+    bool const inPlace = CanUseRecordsInPlace(format);
 
     if (i >= 0)
     {
@@ -209,6 +183,14 @@ char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**
         indexTable = new ptr[recordCount];
     }
 
+    if (inPlace)
+    {
+        for (uint32 y = 0; y < recordCount; ++y)
+            indexTable[i >= 0 ? getRecord(y).getUInt(i) : y] = reinterpret_cast<char*>(data + y * recordSize);
+
+        return nullptr;
+    }
+
     char* dataTable = new char[recordCount * recordsize];
 
     uint32 offset = 0;
@@ -258,15 +240,13 @@ char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**
     return dataTable;
 }
 
-char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
+bool DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
 {
-    if (strlen(format) != fieldCount)
-        return nullptr;
-
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
+    if (strlen(format) != fieldCount || !strchr(format, FT_STRING))
+        return false;
 
     uint32 offset = 0;
+    bool filled = false;
 
     for (uint32 y = 0; y < recordCount; ++y)
     {
@@ -290,8 +270,8 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
                     char** slot = (char**)(&dataTable[offset]);
                     if (!*slot || !**slot)
                     {
-                        const char * st = getRecord(y).getString(x);
-                        *slot = stringPool + (st - (char const*)stringTable);
+                        *slot = const_cast<char*>(getRecord(y).getString(x));
+                        filled = true;
                     }
                     offset += sizeof(char*);
                     break;
@@ -310,5 +290,22 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
         }
     }
 
-    return stringPool;
+    return filled;
+}
+
+bool DBCFileLoader::CanUseRecordsInPlace(char const* format) const
+{
+#if TRINITY_ENDIAN == TRINITY_BIGENDIAN
+    (void)format;
+    return false;
+#else
+    if (strlen(format) != fieldCount || recordSize != fieldCount * sizeof(uint32))
+        return false;
+
+    for (char const* field = format; *field; ++field)
+        if (*field != FT_INT && *field != FT_FLOAT && *field != FT_IND)
+            return false;
+
+    return true;
+#endif
 }
@@ -21,6 +21,15 @@
 #include "Define.h"
 #include "Errors.h"
 #include "Utilities/ByteConverter.h"
+#include <memory>
+
+namespace boost
+{
+    namespace iostreams
+    {
+        class mapped_file;
+    }
+}
 
 enum DbcFieldFormat
 {
@@ -94,8 +103,14 @@ class TC_COMMON_API DBCFileLoader
         uint32 GetCols() const { return fieldCount; }
         uint32 GetOffset(size_t id) const { return (fieldsOffset != nullptr && id < fieldCount) ? fieldsOffset[id] : 0; }
         bool IsLoaded() const { return data != nullptr; }
+        /// Records whose file layout matches the format are used from the mapped file in place, returns nullptr for them
         char* AutoProduceData(char const* fmt, uint32& count, char**& indexTable);
-        char* AutoProduceStrings(char const* fmt, char* dataTable);
+        /// Points string fields that are still unset or empty into the mapped string table, returns true if any of them was set (the table is referenced then)
+        bool AutoProduceStrings(char const* fmt, char* dataTable);
+        /// True if the records can be used without conversion (only 4 byte numeric fields, no skipped columns)
+        bool CanUseRecordsInPlace(char const* fmt) const;
+        /// Keeps the mapped file alive for as long as records or strings produced from it are used
+        std::shared_ptr<void> GetStorage() const { return mapping; }
         static uint32 GetFormatRecordSize(const char * format, int32 * index_pos = nullptr);
     private:
 
@@ -106,6 +121,7 @@ class TC_COMMON_API DBCFileLoader
         uint32 *fieldsOffset;
         unsigned char *data;
         unsigned char *stringTable;
+        std::shared_ptr<boost::iostreams::mapped_file> mapping;
 
         DBCFileLoader(DBCFileLoader const& right) = delete;
         DBCFileLoader& operator=(DBCFileLoader const& right) = delete;
@@ -21,6 +21,7 @@
 #ifdef _WIN32 // Windows
 #include <Windows.h>
 #elif defined(__linux__)
+#include <pthread.h>
 #include <sched.h>
 #include <sys/resource.h>
 #define PROCESS_HIGH_PRIORITY -15 // [-20, 19], default is 0
@@ -95,3 +96,26 @@ void SetProcessPriority(std::string const& logChannel, uint32 affinity, bool hig
     (void)highPriority;
 #endif
 }
+
+void SetCurrentThreadAffinity(std::string const& logChannel, uint32 processor)
+{
+#ifdef _WIN32 // Windows
+
+    if (processor >= sizeof(DWORD_PTR) * 8 || !SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << processor))
+        TC_LOG_ERROR(logChannel, "Can't bind thread to processor {}", processor);
+
+#elif defined(__linux__) // Linux
+
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(processor, &mask);
+
+    if (int error = pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask))
+        TC_LOG_ERROR(logChannel, "Can't bind thread to processor {}, error: {}", processor, strerror(error));
+
+#else
+    // Suppresses unused argument warning for all other platforms
+    (void)logChannel;
+    (void)processor;
+#endif
+}
@@ -19,12 +19,12 @@
 #define __MESSAGEBUFFER_H_
 
 #include "Define.h"
-#include <vector>
+#include "PacketBufferPool.h"
 #include <cstring>
 
 class MessageBuffer
 {
-    typedef std::vector<uint8>::size_type size_type;
+    typedef PacketStorage::size_type size_type;
 
 public:
     MessageBuffer() : _wpos(0), _rpos(0), _storage()
@@ -37,6 +37,11 @@ public:
         _storage.resize(initialSize);
     }
 
+    // takes over storage released by a processed packet, keeping its capacity
+    explicit MessageBuffer(PacketStorage&& storage) : _wpos(0), _rpos(0), _storage(std::move(storage))
+    {
+    }
+
     MessageBuffer(MessageBuffer const& right) : _wpos(right._wpos), _rpos(right._rpos), _storage(right._storage)
     {
     }
@@ -99,7 +104,7 @@ public:
         }
     }
 
-    std::vector<uint8>&& Move()
+    PacketStorage&& Move()
     {
         _wpos = 0;
         _rpos = 0;
@@ -133,7 +138,7 @@ public:
 private:
     size_type _wpos;
     size_type _rpos;
-    std::vector<uint8> _storage;
+    PacketStorage _storage;
 };
 
 #endif /* __MESSAGEBUFFER_H_ */
@@ -0,0 +1,300 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PacketBufferPool.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <new>
+
+using Trinity::PacketBufferPool;
+
+namespace
+{
+constexpr std::size_t ThreadCacheBytesPerClass = 256 * 1024;
+constexpr std::size_t SharedPoolBytesPerClass = 4 * 1024 * 1024;
+constexpr uint64 AllocationCounterFlushInterval = 1024;
+
+struct FreeBlock
+{
+    FreeBlock* Next;
+};
+
+struct FreeList
+{
+    FreeBlock* Head = nullptr;
+    std::size_t Count = 0;
+
+    void Push(void* block)
+    {
+        FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+        freeBlock->Next = Head;
+        Head = freeBlock;
+        ++Count;
+    }
+
+    void* Pop()
+    {
+        FreeBlock* block = Head;
+        if (block)
+        {
+            Head = block->Next;
+            --Count;
+        }
+        return block;
+    }
+
+    // detaches up to count blocks from the front of the list
+    FreeList Split(std::size_t count)
+    {
+        FreeList front;
+        if (!count || !Head)
+            return front;
+
+        FreeBlock* last = Head;
+        front.Count = 1;
+        while (front.Count < count && last->Next)
+        {
+            last = last->Next;
+            ++front.Count;
+        }
+
+        front.Head = Head;
+        Head = last->Next;
+        last->Next = nullptr;
+        Count -= front.Count;
+        return front;
+    }
+};
+
+constexpr std::size_t GetBlockSizeForClass(std::size_t sizeClass)
+{
+    return PacketBufferPool::MinBlockSize << sizeClass;
+}
+
+constexpr std::size_t GetSizeClass(std::size_t size)
+{
+    if (size <= PacketBufferPool::MinBlockSize)
+        return 0;
+
+    return std::bit_width(size - 1) - std::bit_width(PacketBufferPool::MinBlockSize - 1);
+}
+
+static_assert(GetSizeClass(PacketBufferPool::MaxBlockSize) == PacketBufferPool::SizeClassCount - 1);
+
+constexpr std::size_t GetThreadCacheLimit(std::size_t sizeClass)
+{
+    return std::max<std::size_t>(ThreadCacheBytesPerClass / GetBlockSizeForClass(sizeClass), 4);
+}
+
+void FreeBlocks(FreeList& list)
+{
+    while (void* block = list.Pop())
+        ::operator delete(block);
+}
+
+class SharedPool
+{
+public:
+    bool Take(std::size_t sizeClass, FreeList& destination)
+    {
+        SizeClass& pool = _classes[sizeClass];
+        std::lock_guard<std::mutex> lock(pool.Lock);
+        if (pool.Batches.empty())
+            return false;
+
+        destination = pool.Batches.back();
+        pool.Batches.pop_back();
+        pool.Bytes -= destination.Count * GetBlockSizeForClass(sizeClass);
+
+        PooledBytes -= destination.Count * GetBlockSizeForClass(sizeClass);
+        ++SharedPoolTransfers;
+        return true;
+    }
+
+    void Give(std::size_t sizeClass, FreeList batch)
+    {
+        if (!batch.Count)
+            return;
+
+        std::size_t bytes = batch.Count * GetBlockSizeForClass(sizeClass);
+        SizeClass& pool = _classes[sizeClass];
+        {
+            std::lock_guard<std::mutex> lock(pool.Lock);
+            if (pool.Bytes + bytes <= SharedPoolBytesPerClass)
+            {
+                pool.Batches.push_back(batch);
+                pool.Bytes += bytes;
+
+                PooledBytes += bytes;
+                ++SharedPoolTransfers;
+                return;
+            }
+        }
+
+        FreeBlocks(batch);
+    }
+
+    std::atomic<uint64> Allocations = 0;
+    std::atomic<uint64> SystemAllocations = 0;
+    std::atomic<uint64> SharedPoolTransfers = 0;
+    std::atomic<uint64> PooledBytes = 0;
+
+private:
+    struct SizeClass
+    {
+        std::mutex Lock;
+        std::vector<FreeList> Batches;
+        std::size_t Bytes = 0;
+    };
+
+    SizeClass _classes[PacketBufferPool::SizeClassCount];
+};
+
+// never destroyed, buffers owned by static objects may still be released after other statics are gone
+SharedPool& GetSharedPool()
+{
+    static SharedPool* pool = new SharedPool();
+    return *pool;
+}
+
+struct ThreadCache
+{
+    FreeList Lists[PacketBufferPool::SizeClassCount];
+    uint64 PendingAllocations = 0;
+
+    void CountAllocation()
+    {
+        if (++PendingAllocations >= AllocationCounterFlushInterval)
+        {
+            GetSharedPool().Allocations += PendingAllocations;
+            PendingAllocations = 0;
+        }
+    }
+
+    ~ThreadCache();
+};
+
+thread_local ThreadCache* CurrentThreadCache = nullptr;
+thread_local bool ThreadCacheDestroyed = false;
+
+ThreadCache::~ThreadCache()
+{
+    SharedPool& sharedPool = GetSharedPool();
+    for (std::size_t sizeClass = 0; sizeClass < PacketBufferPool::SizeClassCount; ++sizeClass)
+        sharedPool.Give(sizeClass, Lists[sizeClass].Split(Lists[sizeClass].Count));
+
+    sharedPool.Allocations += PendingAllocations;
+
+    CurrentThreadCache = nullptr;
+    ThreadCacheDestroyed = true;
+}
+
+ThreadCache* GetThreadCache()
+{
+    if (!CurrentThreadCache && !ThreadCacheDestroyed)
+    {
+        thread_local ThreadCache cache;
+        CurrentThreadCache = &cache;
+    }
+
+    return CurrentThreadCache;
+}
+}
+
+void* PacketBufferPool::Allocate(std::size_t size)
+{
+    SharedPool& sharedPool = GetSharedPool();
+    ThreadCache* cache = GetThreadCache();
+    if (cache)
+        cache->CountAllocation();
+    else
+        ++sharedPool.Allocations;
+
+    if (size > MaxBlockSize)
+    {
+        ++sharedPool.SystemAllocations;
+        return ::operator new(size);
+    }
+
+    std::size_t sizeClass = GetSizeClass(size);
+    if (cache)
+    {
+        FreeList& list = cache->Lists[sizeClass];
+        if (void* block = list.Pop())
+            return block;
+
+        if (sharedPool.Take(sizeClass, list))
+            return list.Pop();
+    }
+
+    ++sharedPool.SystemAllocations;
+    return ::operator new(GetBlockSizeForClass(sizeClass));
+}
+
+void PacketBufferPool::Deallocate(void* block, std::size_t size) noexcept
+{
+    if (!block)
+        return;
+
+    if (size > MaxBlockSize)
+    {
+        ::operator delete(block);
+        return;
+    }
+
+    std::size_t sizeClass = GetSizeClass(size);
+    ThreadCache* cache = GetThreadCache();
+    if (!cache)
+    {
+        FreeList single;
+        single.Push(block);
+        GetSharedPool().Give(sizeClass, single);
+        return;
+    }
+
+    // keep the most recently freed half of the cache, its blocks are the most likely to still be hot
+    FreeList& list = cache->Lists[sizeClass];
+    list.Push(block);
+    if (list.Count > GetThreadCacheLimit(sizeClass))
+    {
+        FreeList overflow = list.Split(list.Count / 2);
+        std::swap(overflow, list);
+        GetSharedPool().Give(sizeClass, overflow);
+    }
+}
+
+std::size_t PacketBufferPool::GetBlockSize(std::size_t size)
+{
+    if (size > MaxBlockSize)
+        return size;
+
+    return GetBlockSizeForClass(GetSizeClass(size));
+}
+
+PacketBufferPool::Stats PacketBufferPool::GetStats()
+{
+    SharedPool const& sharedPool = GetSharedPool();
+
+    Stats stats;
+    stats.Allocations = sharedPool.Allocations;
+    stats.SystemAllocations = sharedPool.SystemAllocations;
+    stats.SharedPoolTransfers = sharedPool.SharedPoolTransfers;
+    stats.PooledBytes = sharedPool.PooledBytes;
+    return stats;
+}
@@ -0,0 +1,75 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITYCORE_PACKET_BUFFER_POOL_H
+#define TRINITYCORE_PACKET_BUFFER_POOL_H
+
+#include "Define.h"
+#include <cstddef>
+#include <vector>
+
+namespace Trinity
+{
+/// Size class pool backing packet and network buffer storage.
+/// Freed blocks go to a per-thread cache first, overflow is shared between threads through a global list per size class
+/// and anything above that is returned to the system. Requests larger than MaxBlockSize bypass the pool.
+class TC_COMMON_API PacketBufferPool
+{
+public:
+    static constexpr std::size_t MinBlockSize = 64;
+    static constexpr std::size_t SizeClassCount = 9;
+    static constexpr std::size_t MaxBlockSize = MinBlockSize << (SizeClassCount - 1); // 16 KB
+
+    struct Stats
+    {
+        uint64 Allocations = 0;         // all requests, pooled or not
+        uint64 SystemAllocations = 0;   // requests that had to allocate a new block (or were too large to pool)
+        uint64 SharedPoolTransfers = 0; // batches moved between a thread cache and the shared lists
+        uint64 PooledBytes = 0;         // bytes currently held in the shared lists
+    };
+
+    static void* Allocate(std::size_t size);
+    static void Deallocate(void* block, std::size_t size) noexcept;
+
+    /// Size of the block actually used for a request of the given size
+    static std::size_t GetBlockSize(std::size_t size);
+
+    static Stats GetStats();
+};
+
+template<typename T>
+class PacketBufferAllocator
+{
+public:
+    using value_type = T;
+
+    PacketBufferAllocator() noexcept = default;
+
+    template<typename U>
+    PacketBufferAllocator(PacketBufferAllocator<U> const&) noexcept { }
+
+    T* allocate(std::size_t n) { return static_cast<T*>(PacketBufferPool::Allocate(n * sizeof(T))); }
+    void deallocate(T* p, std::size_t n) noexcept { PacketBufferPool::Deallocate(p, n * sizeof(T)); }
+
+    friend bool operator==(PacketBufferAllocator const&, PacketBufferAllocator const&) noexcept { return true; }
+};
+}
+
+/// Byte storage shared by ByteBuffer and MessageBuffer so it can move between them without copying
+using PacketStorage = std::vector<uint8, Trinity::PacketBufferAllocator<uint8>>;
+
+#endif // TRINITYCORE_PACKET_BUFFER_POOL_H
@@ -16,8 +16,10 @@
  */
 
 #include "DatabaseWorker.h"
+#include "MySQLConnection.h"
 #include "SQLOperation.h"
 #include "ProducerConsumerQueue.h"
+#include <mysqld_error.h>
 
 DatabaseWorker::DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection)
 {
@@ -41,18 +43,95 @@ void DatabaseWorker::WorkerThread()
     if (!_queue)
         return;
 
+    SQLOperation* next = nullptr;
+    std::vector<SQLOperation*> batch;
+    batch.reserve(MaxBatchSize);
+
     for (;;)
     {
-        SQLOperation* operation = nullptr;
+        SQLOperation* operation = next;
+        next = nullptr;
 
-        _queue->WaitAndPop(operation);
+        if (!operation)
+            _queue->WaitAndPop(operation);
 
         if (_cancelationToken || !operation)
+        {
+            delete operation;
             return;
+        }
 
         operation->SetConnection(_connection);
-        operation->call();
 
-        delete operation;
+        if (!operation->CanBatch())
+        {
+            operation->call();
+            delete operation;
+            continue;
+        }
+
+        // take the statements queued right behind this one, the first operation that can't join them is run next
+        batch.push_back(operation);
+        while (batch.size() < MaxBatchSize && _queue->Pop(next))
+        {
+            next->SetConnection(_connection);
+            if (!next->CanBatch())
+                break;
+
+            batch.push_back(next);
+            next = nullptr;
+        }
+
+        ExecuteBatch(batch);
+
+        for (SQLOperation* executed : batch)
+            delete executed;
+
+        batch.clear();
     }
 }
+
+void DatabaseWorker::ExecuteBatch(std::vector<SQLOperation*> const& batch)
+{
+    if (batch.size() == 1)
+    {
+        batch.front()->call();
+        return;
+    }
+
+    // one commit for the whole batch instead of one per statement
+    // the transaction must be open on the connection the statements run on, a reconnect while starting it is fine
+    if (!_connection->BeginTransaction())
+    {
+        for (SQLOperation* operation : batch)
+            operation->call();
+        return;
+    }
+
+    uint32 const reconnectCount = _connection->GetReconnectCount();
+
+    std::size_t executed = 0;
+    while (executed < batch.size() && batch[executed]->Execute() && _connection->GetReconnectCount() == reconnectCount)
+        ++executed;
+
+    // a statement that lost a lock conflict inside the batch would have succeeded on its own, so it runs again
+    bool retryStopped = false;
+    if (executed == batch.size())
+    {
+        _connection->CommitTransaction();
+        if (_connection->GetReconnectCount() == reconnectCount)
+            return;
+    }
+    else if (_connection->GetReconnectCount() == reconnectCount)
+    {
+        uint32 const errorCode = _connection->GetLastError();
+        retryStopped = errorCode == ER_LOCK_DEADLOCK || errorCode == ER_LOCK_WAIT_TIMEOUT;
+        _connection->RollbackTransaction();
+    }
+
+    // The transaction is gone. The statement that stopped it has already run on its own (it failed or was retried
+    // after reconnecting) unless it hit a lock conflict, run the others one by one like they would have been without batching
+    for (std::size_t i = 0; i < batch.size(); ++i)
+        if (i != executed || retryStopped)
+            batch[i]->call();
+}
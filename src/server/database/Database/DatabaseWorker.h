@@ -21,6 +21,7 @@
 #include "Define.h"
 #include <atomic>
 #include <thread>
+#include <vector>
 
 template <typename T>
 class ProducerConsumerQueue;
@@ -34,11 +35,15 @@ class TC_DATABASE_API DatabaseWorker
         DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection);
         ~DatabaseWorker();
 
+        //! Maximum number of queued one-way statements committed together
+        static constexpr std::size_t MaxBatchSize = 64;
+
     private:
         ProducerConsumerQueue<SQLOperation*>* _queue;
         MySQLConnection* _connection;
 
         void WorkerThread();
+        void ExecuteBatch(std::vector<SQLOperation*> const& batch);
         std::thread _workerThread;
 
         std::atomic<bool> _cancelationToken;
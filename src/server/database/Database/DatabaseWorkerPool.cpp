@@ -29,6 +29,7 @@
 #include "QueryCallback.h"
 #include "QueryHolder.h"
 #include "QueryResult.h"
+#include "QueryResultSnapshot.h"
 #include "SQLOperation.h"
 #include "Transaction.h"
 #include "MySQLWorkaround.h"
@@ -184,11 +185,25 @@ bool DatabaseWorkerPool<T>::PrepareStatements()
 template <class T>
 QueryResult DatabaseWorkerPool<T>::Query(char const* sql, T* connection /*= nullptr*/)
 {
-    if (!connection)
-        connection = GetFreeConnection();
+    ResultSet* result = nullptr;
+    if (_snapshot && _snapshot->Find(sql, &result))
+    {
+        if (connection)
+            connection->Unlock();
+    }
+    else
+    {
+        if (!connection)
+            connection = GetFreeConnection();
+
+        result = connection->Query(sql);
+        bool const failed = !result && connection->GetLastError();
+        connection->Unlock();
+
+        if (_snapshot && !failed)
+            result = _snapshot->Record(sql, result);
+    }
 
-    ResultSet* result = connection->Query(sql);
-    connection->Unlock();
     if (!result || !result->GetRowCount() || !result->NextRow())
     {
         delete result;
@@ -256,6 +271,8 @@ SQLTransaction<T> DatabaseWorkerPool<T>::BeginTransaction()
 template <class T>
 void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction)
 {
+    InvalidateSnapshot();
+
 #ifdef TRINITY_DEBUG
     //! Only analyze transaction weaknesses in Debug mode.
     //! Ideally we catch the faults in Debug mode and then correct them,
@@ -279,6 +296,8 @@ void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction)
 template <class T>
 TransactionCallback DatabaseWorkerPool<T>::AsyncCommitTransaction(SQLTransaction<T> transaction)
 {
+    InvalidateSnapshot();
+
 #ifdef TRINITY_DEBUG
     //! Only analyze transaction weaknesses in Debug mode.
     //! Ideally we catch the faults in Debug mode and then correct them,
@@ -305,6 +324,8 @@ TransactionCallback DatabaseWorkerPool<T>::AsyncCommitTransaction(SQLTransaction
 template <class T>
 void DatabaseWorkerPool<T>::DirectCommitTransaction(SQLTransaction<T>& transaction)
 {
+    InvalidateSnapshot();
+
     T* connection = GetFreeConnection();
     int errorCode = connection->ExecuteTransaction(transaction);
     if (!errorCode)
@@ -473,12 +494,41 @@ char const* DatabaseWorkerPool<T>::GetDatabaseName() const
     return _connectionInfo->database.c_str();
 }
 
+template <class T>
+void DatabaseWorkerPool<T>::OpenSnapshot(std::string const& path, std::string const& version)
+{
+    if (version.empty())
+    {
+        TC_LOG_ERROR("sql.driver", "Cannot use a query result snapshot for DatabasePool '{}' without knowing its version.", GetDatabaseName());
+        return;
+    }
+
+    _snapshot = std::make_unique<QueryResultSnapshot>(path, version);
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::CloseSnapshot()
+{
+    // kept after closing, later writes still have to discard the saved file
+    if (_snapshot)
+        _snapshot->Close();
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::InvalidateSnapshot()
+{
+    if (_snapshot)
+        _snapshot->Invalidate();
+}
+
 template <class T>
 void DatabaseWorkerPool<T>::Execute(char const* sql)
 {
     if (Trinity::IsFormatEmptyOrNull(sql))
         return;
 
+    InvalidateSnapshot();
+
     BasicStatementTask* task = new BasicStatementTask(sql);
     Enqueue(task);
 }
@@ -486,6 +536,8 @@ void DatabaseWorkerPool<T>::Execute(char const* sql)
 template <class T>
 void DatabaseWorkerPool<T>::Execute(PreparedStatement<T>* stmt)
 {
+    InvalidateSnapshot();
+
     PreparedStatementTask* task = new PreparedStatementTask(stmt);
     Enqueue(task);
 }
@@ -496,6 +548,8 @@ void DatabaseWorkerPool<T>::DirectExecute(char const* sql)
     if (Trinity::IsFormatEmptyOrNull(sql))
         return;
 
+    InvalidateSnapshot();
+
     T* connection = GetFreeConnection();
     connection->Execute(sql);
     connection->Unlock();
@@ -504,6 +558,8 @@ void DatabaseWorkerPool<T>::DirectExecute(char const* sql)
 template <class T>
 void DatabaseWorkerPool<T>::DirectExecute(PreparedStatement<T>* stmt)
 {
+    InvalidateSnapshot();
+
     T* connection = GetFreeConnection();
     connection->Execute(stmt);
     connection->Unlock();
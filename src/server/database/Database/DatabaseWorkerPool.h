@@ -22,12 +22,14 @@
 #include "DatabaseEnvFwd.h"
 #include "StringFormat.h"
 #include <array>
+#include <memory>
 #include <string>
 #include <vector>
 
 template <typename T>
 class ProducerConsumerQueue;
 
+class QueryResultSnapshot;
 class SQLOperation;
 struct MySQLConnectionInfo;
 
@@ -215,6 +217,13 @@ class DatabaseWorkerPool
 
         size_t QueueSize() const;
 
+        //! Answers string queries from the snapshot stored at path if it was made for the given version, records their results into it otherwise.
+        //! Any write through this pool discards the snapshot.
+        void OpenSnapshot(std::string const& path, std::string const& version);
+
+        //! Stops answering queries from the snapshot and saves it if it was recorded.
+        void CloseSnapshot();
+
     private:
         uint32 OpenConnections(InternalIndex type, uint8 numConnections);
 
@@ -228,12 +237,15 @@ class DatabaseWorkerPool
 
         char const* GetDatabaseName() const;
 
+        void InvalidateSnapshot();
+
         //! Queue shared by async worker threads.
         std::unique_ptr<ProducerConsumerQueue<SQLOperation*>> _queue;
         std::array<std::vector<std::unique_ptr<T>>, IDX_SIZE> _connections;
         std::unique_ptr<MySQLConnectionInfo> _connectionInfo;
         std::vector<uint8> _preparedStatementSize;
         uint8 _async_threads, _synch_threads;
+        std::unique_ptr<QueryResultSnapshot> _snapshot;
 #ifdef TRINITY_DEBUG
         static inline thread_local bool _warnSyncQueries = false;
 #endif
@@ -513,16 +513,12 @@ enum CharacterDatabaseStatements : uint32
     // NPCBot
     CHAR_UPD_NPCBOT_OWNER,
     CHAR_UPD_NPCBOT_OWNER_ALL,
-    CHAR_UPD_NPCBOT_ROLES,
     CHAR_SEL_NPCBOT_EQUIP_BY_ITEM_INSTANCE,
     CHAR_UPD_NPCBOT_EQUIP,
     CHAR_UPD_NPCBOT_EQUIP_RESET_ALL,
     CHAR_DEL_NPCBOT,
     CHAR_INS_NPCBOT,
-    CHAR_UPD_NPCBOT_FACTION,
-    CHAR_UPD_NPCBOT_SPEC,
-    CHAR_UPD_NPCBOT_DISABLED_SPELLS,
-    CHAR_UPD_NPCBOT_MISCVALUES,
+    CHAR_UPD_NPCBOT_DATA,
     CHAR_REP_NPCBOT_STATS,
     CHAR_REP_NPCBOT_TRANSMOG,
     CHAR_DEL_NPCBOT_TRANSMOG,
@@ -532,12 +528,16 @@ enum CharacterDatabaseStatements : uint32
     CHAR_DEL_NPCBOT_GROUP_MEMBER_ALL,
     CHAR_UPD_NPCBOT_GROUP_MEMBER_FLAG,
     CHAR_INS_NPCBOT_LOG,
+    CHAR_INS_NPCBOT_LOG_BATCH,
     CHAR_SEL_NPCBOT_ACC_BOT_COUNT,
     // End NPCBot
 
     MAX_CHARACTERDATABASE_STATEMENTS
 };
 
+// rows inserted by one CHAR_INS_NPCBOT_LOG_BATCH, 11 parameters per row must stay within uint8 parameter indices
+constexpr uint32 NPCBOT_LOG_BATCH_ROWS = 16;
+
 class TC_DATABASE_API CharacterDatabaseConnection : public MySQLConnection
 {
 public:
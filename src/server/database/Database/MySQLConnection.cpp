@@ -50,6 +50,7 @@ MySQLConnectionInfo::MySQLConnectionInfo(std::string const& infoString)
 MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_reconnectCount(0),
 m_queue(nullptr),
 m_Mysql(nullptr),
 m_connectionInfo(connInfo),
@@ -58,6 +59,7 @@ m_connectionFlags(CONNECTION_SYNCH) { }
 MySQLConnection::MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_reconnectCount(0),
 m_queue(queue),
 m_Mysql(nullptr),
 m_connectionInfo(connInfo),
@@ -371,9 +373,9 @@ bool MySQLConnection::_Query(const char* sql, MySQLResult** pResult, MySQLField*
     return true;
 }
 
-void MySQLConnection::BeginTransaction()
+bool MySQLConnection::BeginTransaction()
 {
-    Execute("START TRANSACTION");
+    return Execute("START TRANSACTION");
 }
 
 void MySQLConnection::RollbackTransaction()
@@ -467,6 +469,12 @@ uint32 MySQLConnection::GetServerVersion() const
     return mysql_get_server_version(m_Mysql);
 }
 
+bool MySQLConnection::CommitsImplicitly(uint32 index)
+{
+    // missing statements are reported when executed
+    return index < m_stmts.size() && m_stmts[index] && m_stmts[index]->CommitsImplicitly();
+}
+
 MySQLPreparedStatement* MySQLConnection::GetPreparedStatement(uint32 index)
 {
     ASSERT(index < m_stmts.size(), "Tried to access invalid prepared statement index %u (max index " SZFMTD ") on database `%s`, connection type: %s",
@@ -567,6 +575,7 @@ bool MySQLConnection::_HandleMySQLErrno(uint32 errNo, uint8 attempts /*= 5*/)
                         (m_connectionFlags & CONNECTION_ASYNC) ? "asynchronous" : "synchronous");
 
                 m_reconnecting = false;
+                ++m_reconnectCount;
                 return true;
             }
 
@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -74,7 +75,7 @@ class TC_DATABASE_API MySQLConnection
         bool _Query(char const* sql, MySQLResult** pResult, MySQLField** pFields, uint64* pRowCount, uint32* pFieldCount);
         bool _Query(PreparedStatementBase* stmt, MySQLPreparedStatement** mysqlStmt, MySQLResult** pResult, uint64* pRowCount, uint32* pFieldCount);
 
-        void BeginTransaction();
+        bool BeginTransaction();
         void RollbackTransaction();
         void CommitTransaction();
         int ExecuteTransaction(std::shared_ptr<TransactionBase> transaction);
@@ -83,6 +84,12 @@ class TC_DATABASE_API MySQLConnection
 
         uint32 GetLastError();
 
+        //! Statement ends the open transaction when run, see MySQLPreparedStatement::CommitsImplicitly
+        bool CommitsImplicitly(uint32 index);
+
+        //! Number of times the connection was lost and opened again, anything sent in an open transaction before that is gone.
+        uint32 GetReconnectCount() const { return m_reconnectCount; }
+
     protected:
         /// Tries to acquire lock. If lock is acquired by another thread
         /// the calling parent will just try another connection
@@ -102,6 +109,7 @@ class TC_DATABASE_API MySQLConnection
         PreparedStatementContainer           m_stmts;         //! PreparedStatements storage
         bool                                 m_reconnecting;  //! Are we reconnecting?
         bool                                 m_prepareError;  //! Was there any error while preparing statements?
+        std::atomic<uint32>                  m_reconnectCount; //! Successful reconnections
 
     private:
         bool _HandleMySQLErrno(uint32 errNo, uint8 attempts = 5);
@@ -20,6 +20,7 @@
 #include "Log.h"
 #include "MySQLHacks.h"
 #include "PreparedStatement.h"
+#include "Util.h"
 #include <chrono>
 #include <cstring>
 
@@ -37,8 +38,17 @@ template<> struct MySQLType<int64> : std::integral_constant<enum_field_types, MY
 template<> struct MySQLType<float> : std::integral_constant<enum_field_types, MYSQL_TYPE_FLOAT> { };
 template<> struct MySQLType<double> : std::integral_constant<enum_field_types, MYSQL_TYPE_DOUBLE> { };
 
+static bool IsImplicitCommit(std::string const& queryString)
+{
+    for (char const* statement : { "TRUNCATE", "ALTER", "CREATE", "DROP", "RENAME", "LOCK" })
+        if (StringStartsWithI(queryString, statement))
+            return true;
+
+    return false;
+}
+
 MySQLPreparedStatement::MySQLPreparedStatement(MySQLStmt* stmt, std::string queryString) :
-    m_stmt(nullptr), m_Mstmt(stmt), m_bind(nullptr), m_queryString(std::move(queryString))
+    m_stmt(nullptr), m_Mstmt(stmt), m_bind(nullptr), m_queryString(std::move(queryString)), m_commitsImplicitly(IsImplicitCommit(m_queryString))
 {
     /// Initialize variable parameters
     m_paramCount = mysql_stmt_param_count(stmt);
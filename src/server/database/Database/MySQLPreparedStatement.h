@@ -44,6 +44,9 @@ class TC_DATABASE_API MySQLPreparedStatement
 
         uint32 GetParameterCount() const { return m_paramCount; }
 
+        //! DDL statements (TRUNCATE, ALTER, ...) commit the open transaction before and after running
+        bool CommitsImplicitly() const { return m_commitsImplicitly; }
+
     protected:
         void SetParameter(uint8 index, std::nullptr_t);
         void SetParameter(uint8 index, bool value);
@@ -66,6 +69,7 @@ class TC_DATABASE_API MySQLPreparedStatement
         std::vector<bool> m_paramsSet;
         MySQLBind* m_bind;
         std::string const m_queryString;
+        bool const m_commitsImplicitly;
 
         MySQLPreparedStatement(MySQLPreparedStatement const& right) = delete;
         MySQLPreparedStatement& operator=(MySQLPreparedStatement const& right) = delete;
@@ -160,6 +160,12 @@ bool PreparedStatementTask::Execute()
     return m_conn->Execute(m_stmt);
 }
 
+bool PreparedStatementTask::CanBatch() const
+{
+    // statements committing on their own would end the batch transaction halfway
+    return !m_has_result && !m_conn->CommitsImplicitly(m_stmt->GetIndex());
+}
+
 template<typename T>
 std::string PreparedStatementData::ToString(T value)
 {
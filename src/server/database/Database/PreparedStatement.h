@@ -123,6 +123,7 @@ class TC_DATABASE_API PreparedStatementTask : public SQLOperation
         ~PreparedStatementTask();
 
         bool Execute() override;
+        bool CanBatch() const override;
         PreparedQueryResultFuture GetFuture() { return m_result->get_future(); }
 
     protected:
@@ -22,6 +22,7 @@
 #include "Log.h"
 #include "MySQLHacks.h"
 #include "MySQLWorkaround.h"
+#include "QueryResultSnapshot.h"
 #include <chrono>
 #include <cstring>
 
@@ -380,6 +381,25 @@ std::unique_ptr<BaseDatabaseResultValueConverter> const BinaryValueConverters[15
     std::make_unique<StringResultValueConverter>()
 };
 
+char const* ColumnTypeToString(DatabaseFieldTypes type)
+{
+    switch (type)
+    {
+        case DatabaseFieldTypes::UInt8:  return "uint8";
+        case DatabaseFieldTypes::Int8:   return "int8";
+        case DatabaseFieldTypes::UInt16: return "uint16";
+        case DatabaseFieldTypes::Int16:  return "int16";
+        case DatabaseFieldTypes::UInt32: return "uint32";
+        case DatabaseFieldTypes::Int32:  return "int32";
+        case DatabaseFieldTypes::UInt64: return "uint64";
+        case DatabaseFieldTypes::Int64:  return "int64";
+        case DatabaseFieldTypes::Float:  return "float";
+        case DatabaseFieldTypes::Double: return "double";
+        case DatabaseFieldTypes::Binary: return "std::string_view";
+        default:                         return "-Unknown-";
+    }
+}
+
 void InitializeDatabaseFieldMetadata(QueryResultFieldMetadata* meta, MySQLField const* field, uint32 fieldIndex, bool binaryProtocol)
 {
     meta->TableName = field->org_table;
@@ -397,7 +417,26 @@ ResultSet::ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, u
 _rowCount(rowCount),
 _fieldCount(fieldCount),
 _result(result),
-_fields(fields)
+_fields(fields),
+_snapshotRow(nullptr),
+_snapshotRowsLeft(0)
+{
+    InitializeFields();
+}
+
+ResultSet::ResultSet(MySQLField* fields, uint64 rowCount, uint32 fieldCount, char const* snapshotRows, std::shared_ptr<void const> snapshotStorage) :
+_rowCount(rowCount),
+_fieldCount(fieldCount),
+_result(nullptr),
+_fields(fields),
+_snapshotRow(snapshotRows),
+_snapshotRowsLeft(rowCount),
+_snapshotStorage(std::move(snapshotStorage))
+{
+    InitializeFields();
+}
+
+void ResultSet::InitializeFields()
 {
     _fieldMetadata.resize(_fieldCount);
     _currentRow = new Field[_fieldCount];
@@ -452,13 +491,20 @@ m_metadataResult(result)
     //- This is where we prepare the buffer based on metadata
     MySQLField* field = reinterpret_cast<MySQLField*>(mysql_fetch_fields(m_metadataResult));
     m_fieldMetadata.resize(m_fieldCount);
-    std::size_t rowSize = 0;
+    m_columns.resize(m_fieldCount);
+    m_currentRow.resize(m_fieldCount);
+    std::vector<std::size_t> columnOffsets(m_fieldCount);
+    std::size_t bufferSize = 0;
     for (uint32 i = 0; i < m_fieldCount; ++i)
     {
         uint32 size = SizeForType(&field[i]);
-        rowSize += size;
+
+        // values of a column are stored next to each other, keep every column aligned for the largest numeric type
+        columnOffsets[i] = bufferSize;
+        bufferSize += (size * m_rowCount + alignof(uint64) - 1) & ~(alignof(uint64) - 1);
 
         InitializeDatabaseFieldMetadata(&m_fieldMetadata[i], &field[i], i, true);
+        m_currentRow[i].SetMetadata(&m_fieldMetadata[i]);
 
         m_rBind[i].buffer_type = field[i].type;
         m_rBind[i].buffer_length = size;
@@ -468,11 +514,12 @@ m_metadataResult(result)
         m_rBind[i].is_unsigned = field[i].flags & UNSIGNED_FLAG;
     }
 
-    char* dataBuffer = new char[rowSize * m_rowCount];
-    for (uint32 i = 0, offset = 0; i < m_fieldCount; ++i)
+    char* dataBuffer = new char[bufferSize];
+    for (uint32 i = 0; i < m_fieldCount; ++i)
     {
-        m_rBind[i].buffer = dataBuffer + offset;
-        offset += m_rBind[i].buffer_length;
+        m_rBind[i].buffer = dataBuffer + columnOffsets[i];
+        m_columns[i].Data = dataBuffer + columnOffsets[i];
+        m_columns[i].Size = m_rBind[i].buffer_length;
     }
 
     //- This is where we bind the bind the buffer to the statement
@@ -486,18 +533,16 @@ m_metadataResult(result)
         return;
     }
 
-    m_rows.resize(std::size_t(m_rowCount) * m_fieldCount);
+    m_lengths.assign(std::size_t(m_rowCount) * m_fieldCount, NullValueLength);
     while (_NextRow())
     {
         for (uint32 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
         {
-            m_rows[std::size_t(m_rowPosition) * m_fieldCount + fIndex].SetMetadata(&m_fieldMetadata[fIndex]);
-
             unsigned long buffer_length = m_rBind[fIndex].buffer_length;
             unsigned long fetched_length = *m_rBind[fIndex].length;
+            void* buffer = m_stmt->bind[fIndex].buffer;
             if (!*m_rBind[fIndex].is_null)
             {
-                void* buffer = m_stmt->bind[fIndex].buffer;
                 switch (m_rBind[fIndex].buffer_type)
                 {
                     case MYSQL_TYPE_TINY_BLOB:
@@ -518,24 +563,21 @@ m_metadataResult(result)
                         break;
                 }
 
-                m_rows[std::size_t(m_rowPosition) * m_fieldCount + fIndex].SetValue(
-                    (char const*)buffer,
-                    fetched_length);
-
-                // move buffer pointer to next part
-                m_stmt->bind[fIndex].buffer = (char*)buffer + rowSize;
+                m_lengths[std::size_t(m_rowPosition) * m_fieldCount + fIndex] = fetched_length;
             }
             else
-            {
-                m_rows[std::size_t(m_rowPosition) * m_fieldCount + fIndex].SetValue(
-                    nullptr,
-                    *m_rBind[fIndex].length);
-            }
+                memset(buffer, 0, buffer_length); // NULL reads as 0 through GetColumn
+
+            // move buffer pointer to the value of the next row
+            m_stmt->bind[fIndex].buffer = (char*)buffer + buffer_length;
         }
         m_rowPosition++;
     }
     m_rowPosition = 0;
 
+    if (m_rowCount)
+        SetCurrentRow();
+
     /// All data is buffered, let go of mysql c api structures
     mysql_stmt_free_result(m_stmt);
 }
@@ -552,6 +594,19 @@ PreparedResultSet::~PreparedResultSet()
 
 bool ResultSet::NextRow()
 {
+    if (_snapshotRow)
+    {
+        if (!_snapshotRowsLeft)
+        {
+            CleanUp();
+            return false;
+        }
+
+        --_snapshotRowsLeft;
+        _snapshotRow = QueryResultSnapshot::ReadRow(_snapshotRow, _currentRow, _fieldCount);
+        return true;
+    }
+
     if (!_result)
         return false;
 
@@ -578,14 +633,26 @@ bool ResultSet::NextRow()
 
 bool PreparedResultSet::NextRow()
 {
-    /// Only updates the m_rowPosition so upper level code knows in which element
-    /// of the rows vector to look
+    /// Rows are already buffered, only points the fields of the current row to the next one
     if (++m_rowPosition >= m_rowCount)
         return false;
 
+    SetCurrentRow();
     return true;
 }
 
+void PreparedResultSet::SetCurrentRow()
+{
+    for (uint32 i = 0; i < m_fieldCount; ++i)
+    {
+        uint32 length = m_lengths[std::size_t(m_rowPosition) * m_fieldCount + i];
+        if (length != NullValueLength)
+            m_currentRow[i].SetValue(m_columns[i].Data + std::size_t(m_rowPosition) * m_columns[i].Size, length);
+        else
+            m_currentRow[i].SetValue(nullptr, 0);
+    }
+}
+
 bool PreparedResultSet::_NextRow()
 {
     /// Only called in low-level code, namely the constructor
@@ -610,6 +677,9 @@ void ResultSet::CleanUp()
         mysql_free_result(_result);
         _result = nullptr;
     }
+
+    _snapshotRow = nullptr;
+    _snapshotStorage.reset();
 }
 
 Field const& ResultSet::operator[](std::size_t index) const
@@ -627,14 +697,14 @@ QueryResultFieldMetadata const& ResultSet::GetFieldMetadata(std::size_t index) c
 Field* PreparedResultSet::Fetch() const
 {
     ASSERT(m_rowPosition < m_rowCount);
-    return const_cast<Field*>(&m_rows[std::size_t(m_rowPosition) * m_fieldCount]);
+    return const_cast<Field*>(m_currentRow.data());
 }
 
 Field const& PreparedResultSet::operator[](std::size_t index) const
 {
     ASSERT(m_rowPosition < m_rowCount);
     ASSERT(index < std::size_t(m_fieldCount));
-    return m_rows[std::size_t(m_rowPosition) * m_fieldCount + index];
+    return m_currentRow[index];
 }
 
 QueryResultFieldMetadata const& PreparedResultSet::GetFieldMetadata(std::size_t index) const
@@ -643,6 +713,26 @@ QueryResultFieldMetadata const& PreparedResultSet::GetFieldMetadata(std::size_t
     return m_fieldMetadata[index];
 }
 
+bool PreparedResultSet::HasColumnCount(std::size_t count) const
+{
+    if (count == m_fieldCount)
+        return true;
+
+    TC_LOG_ERROR("sql.sql", "Expected {} columns in result of a query, got {}", count, m_fieldCount);
+    return false;
+}
+
+bool PreparedResultSet::IsColumnOfType(std::size_t index, DatabaseFieldTypes type) const
+{
+    QueryResultFieldMetadata const& meta = GetFieldMetadata(index);
+    if (meta.Type == type)
+        return true;
+
+    TC_LOG_ERROR("sql.sql", "{} field {}.{} ({}.{}) at index {} can't be read as {}",
+        meta.TypeName, meta.TableAlias, meta.Alias, meta.TableName, meta.Name, index, ColumnTypeToString(type));
+    return false;
+}
+
 void PreparedResultSet::CleanUp()
 {
     if (m_metadataResult)
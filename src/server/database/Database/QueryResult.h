@@ -20,12 +20,25 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include "Field.h"
+#include "Types.h"
+#include <limits>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 class TC_DATABASE_API ResultSet
 {
+    friend class QueryResultSnapshot;
+
     public:
         ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, uint32 fieldCount);
+        //! Reads rows stored by QueryResultSnapshot, storage keeps row data and field descriptions alive
+        ResultSet(MySQLField* fields, uint64 rowCount, uint32 fieldCount, char const* snapshotRows, std::shared_ptr<void const> snapshotStorage);
         ~ResultSet();
 
         bool NextRow();
@@ -44,9 +57,13 @@ class TC_DATABASE_API ResultSet
         uint32 _fieldCount;
 
     private:
+        void InitializeFields();
         void CleanUp();
         MySQLResult* _result;
         MySQLField* _fields;
+        char const* _snapshotRow;
+        uint64 _snapshotRowsLeft;
+        std::shared_ptr<void const> _snapshotStorage;
 
         ResultSet(ResultSet const& right) = delete;
         ResultSet& operator=(ResultSet const& right) = delete;
@@ -62,14 +79,59 @@ class TC_DATABASE_API PreparedResultSet
         uint64 GetRowCount() const { return m_rowCount; }
         uint32 GetFieldCount() const { return m_fieldCount; }
 
+        //! Fields of the current row, updated in place by NextRow
         Field* Fetch() const;
         Field const& operator[](std::size_t index) const;
 
         QueryResultFieldMetadata const& GetFieldMetadata(std::size_t index) const;
 
+        //! Column access without Field, values point into the buffer rows were fetched into and stay valid as long as the result set.
+        //! No type checks are made here, use PreparedResultSchema to validate the columns once.
+        //! Values of a column in every row, T must be the exact type of the column. NULL values read as 0.
+        template <typename T>
+        std::span<T const> GetColumn(std::size_t index) const
+        {
+            return { reinterpret_cast<T const*>(m_columns[index].Data), std::size_t(m_rowCount) };
+        }
+
+        bool IsNull(uint64 row, std::size_t index) const { return m_lengths[std::size_t(row) * m_fieldCount + index] == NullValueLength; }
+
+        //! Text or binary value, empty for NULL
+        std::string_view GetStringView(uint64 row, std::size_t index) const
+        {
+            uint32 length = m_lengths[std::size_t(row) * m_fieldCount + index];
+            if (length == NullValueLength)
+                return {};
+
+            return { m_columns[index].Data + std::size_t(row) * m_columns[index].Size, length };
+        }
+
+        template <typename T>
+        T GetValue(uint64 row, std::size_t index) const
+        {
+            if constexpr (std::is_same_v<T, std::string_view>)
+                return GetStringView(row, index);
+            else
+                return GetColumn<T>(index)[row];
+        }
+
+        //! Log an error when the result doesn't match what the caller expects
+        bool HasColumnCount(std::size_t count) const;
+        bool IsColumnOfType(std::size_t index, DatabaseFieldTypes type) const;
+
     protected:
+        struct Column
+        {
+            char* Data;                 // value of every row, Size bytes apart
+            uint32 Size;
+        };
+
+        static constexpr uint32 NullValueLength = std::numeric_limits<uint32>::max();
+
         std::vector<QueryResultFieldMetadata> m_fieldMetadata;
-        std::vector<Field> m_rows;
+        std::vector<Column> m_columns;
+        std::vector<uint32> m_lengths;  // fetched value length for every row and column
+        std::vector<Field> m_currentRow;
         uint64 m_rowCount;
         uint64 m_rowPosition;
         uint32 m_fieldCount;
@@ -81,9 +143,86 @@ class TC_DATABASE_API PreparedResultSet
 
         void CleanUp();
         bool _NextRow();
+        void SetCurrentRow();
 
         PreparedResultSet(PreparedResultSet const& right) = delete;
         PreparedResultSet& operator=(PreparedResultSet const& right) = delete;
 };
 
+namespace Trinity::Impl
+{
+    template <typename T>
+    constexpr DatabaseFieldTypes GetPreparedColumnType()
+    {
+        if constexpr (std::is_same_v<T, uint8>)
+            return DatabaseFieldTypes::UInt8;
+        else if constexpr (std::is_same_v<T, int8>)
+            return DatabaseFieldTypes::Int8;
+        else if constexpr (std::is_same_v<T, uint16>)
+            return DatabaseFieldTypes::UInt16;
+        else if constexpr (std::is_same_v<T, int16>)
+            return DatabaseFieldTypes::Int16;
+        else if constexpr (std::is_same_v<T, uint32>)
+            return DatabaseFieldTypes::UInt32;
+        else if constexpr (std::is_same_v<T, int32>)
+            return DatabaseFieldTypes::Int32;
+        else if constexpr (std::is_same_v<T, uint64>)
+            return DatabaseFieldTypes::UInt64;
+        else if constexpr (std::is_same_v<T, int64>)
+            return DatabaseFieldTypes::Int64;
+        else if constexpr (std::is_same_v<T, float>)
+            return DatabaseFieldTypes::Float;
+        else if constexpr (std::is_same_v<T, double>)
+            return DatabaseFieldTypes::Double;
+        else if constexpr (std::is_same_v<T, std::string_view>)
+            return DatabaseFieldTypes::Binary;
+        else
+            static_assert(Trinity::dependant_false_v<T>, "Unsupported column type used in PreparedResultSchema");
+    }
+}
+
+/**
+    @class PreparedResultSchema
+
+    @brief Column types of a prepared statement result, checked once per result instead of on every value read
+
+    Numeric columns must have the exact type listed (signedness included), text and blob columns are read as std::string_view.
+
+    @code
+    using ItemRow = PreparedResultSchema<uint32, uint32, std::string_view>;
+    if (ItemRow::Validate(*result))
+        for (uint64 row = 0; row < result->GetRowCount(); ++row)
+            auto [guid, entry, text] = ItemRow::GetRow(*result, row);
+    @endcode
+*/
+template <typename... Columns>
+class PreparedResultSchema
+{
+    public:
+        using Row = std::tuple<Columns...>;
+
+        static bool Validate(PreparedResultSet const& result)
+        {
+            return result.HasColumnCount(sizeof...(Columns)) && ValidateColumns(result, std::index_sequence_for<Columns...>());
+        }
+
+        static Row GetRow(PreparedResultSet const& result, uint64 row)
+        {
+            return GetRow(result, row, std::index_sequence_for<Columns...>());
+        }
+
+    private:
+        template <std::size_t... Indexes>
+        static bool ValidateColumns(PreparedResultSet const& result, std::index_sequence<Indexes...>)
+        {
+            return (result.IsColumnOfType(Indexes, Trinity::Impl::GetPreparedColumnType<Columns>()) && ...);
+        }
+
+        template <std::size_t... Indexes>
+        static Row GetRow(PreparedResultSet const& result, uint64 row, std::index_sequence<Indexes...>)
+        {
+            return Row(result.template GetValue<Columns>(row, Indexes)...);
+        }
+};
+
 #endif
@@ -0,0 +1,431 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "QueryResultSnapshot.h"
+#include "Field.h"
+#include "Log.h"
+#include "MySQLHacks.h"
+#include "QueryResult.h"
+#include <boost/filesystem/operations.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <cstring>
+#include <vector>
+
+/*
+    File layout, integers are stored in native byte order:
+
+    uint32 magic, uint32 format version, string version, uint32 entry count
+    entries:
+        string sql
+        uint32 field count, uint64 row count
+        per field: uint32 mysql type, uint32 flags, string table, string table alias, string name, string alias
+        uint64 row data size
+        per row and field: uint32 length (NullValueLength for NULL), value bytes, '\0'
+
+    strings are stored as uint32 length, bytes, '\0'
+*/
+
+namespace
+{
+constexpr uint32 SnapshotMagic = 0x53525154; // "TQRS"
+constexpr uint32 SnapshotFormatVersion = 1;
+constexpr uint32 NullValueLength = 0xFFFFFFFF;
+
+template<typename T>
+void Append(std::string& buffer, T value)
+{
+    buffer.append(reinterpret_cast<char const*>(&value), sizeof(T));
+}
+
+void AppendString(std::string& buffer, char const* str, std::size_t length)
+{
+    Append(buffer, uint32(length));
+    buffer.append(str, length);
+    buffer.push_back('\0');
+}
+
+void AppendString(std::string& buffer, char const* str)
+{
+    AppendString(buffer, str ? str : "", str ? strlen(str) : 0);
+}
+
+// end may be nullptr to skip bounds checks
+class SnapshotReader
+{
+public:
+    SnapshotReader(char const* data, char const* end) : _data(data), _end(end) { }
+
+    template<typename T>
+    bool Read(T& value)
+    {
+        if (_end && std::size_t(_end - _data) < sizeof(T))
+            return false;
+
+        memcpy(&value, _data, sizeof(T));
+        _data += sizeof(T);
+        return true;
+    }
+
+    bool ReadString(std::string_view& value)
+    {
+        uint32 length;
+        if (!Read(length) || (_end && std::size_t(_end - _data) <= length))
+            return false;
+
+        value = std::string_view(_data, length);
+        _data += length + 1;
+        return true;
+    }
+
+    bool Skip(uint64 size)
+    {
+        if (_end && uint64(_end - _data) < size)
+            return false;
+
+        _data += size;
+        return true;
+    }
+
+    char const* GetPosition() const { return _data; }
+
+private:
+    char const* _data;
+    char const* _end;
+};
+
+// field descriptions of a result set read from the snapshot, strings point into the entry
+struct SnapshotResultStorage
+{
+    std::vector<MySQLField> Fields;
+    std::shared_ptr<void const> Entry;
+};
+
+// checks the structure of one entry, values are only validated through the row data size
+bool ValidateEntry(SnapshotReader& reader)
+{
+    uint32 fieldCount;
+    uint64 rowCount;
+    if (!reader.Read(fieldCount) || !reader.Read(rowCount))
+        return false;
+
+    for (uint32 i = 0; i < fieldCount; ++i)
+    {
+        uint32 type, flags;
+        std::string_view table, tableAlias, name, alias;
+        if (!reader.Read(type) || !reader.Read(flags)
+            || !reader.ReadString(table) || !reader.ReadString(tableAlias) || !reader.ReadString(name) || !reader.ReadString(alias))
+            return false;
+    }
+
+    uint64 rowDataSize;
+    return reader.Read(rowDataSize) && reader.Skip(rowDataSize);
+}
+}
+
+QueryResultSnapshot::QueryResultSnapshot(std::string path, std::string version) :
+    _path(std::move(path)), _version(std::move(version)), _state(State::Closed), _invalidated(false),
+    _hits(0), _misses(0), _entryCountOffset(0), _recordedEntries(0)
+{
+    if (Load())
+    {
+        _state = State::Reading;
+        TC_LOG_INFO("sql.driver", "Answering queries from snapshot {} ({} results).", _path, _entries.size());
+    }
+    else
+        StartRecording();
+}
+
+QueryResultSnapshot::~QueryResultSnapshot()
+{
+    Close();
+}
+
+bool QueryResultSnapshot::Load()
+{
+    boost::system::error_code error;
+    if (!boost::filesystem::is_regular_file(_path, error))
+        return false;
+
+    std::shared_ptr<boost::iostreams::mapped_file_source> mapping = std::make_shared<boost::iostreams::mapped_file_source>();
+    try
+    {
+        mapping->open(_path);
+    }
+    catch (std::exception const& e)
+    {
+        TC_LOG_ERROR("sql.driver", "Could not map query result snapshot {}: {}", _path, e.what());
+        return false;
+    }
+
+    SnapshotReader reader(mapping->data(), mapping->data() + mapping->size());
+    uint32 magic, formatVersion, entryCount;
+    std::string_view version;
+    if (!reader.Read(magic) || magic != SnapshotMagic || !reader.Read(formatVersion) || formatVersion != SnapshotFormatVersion
+        || !reader.ReadString(version) || !reader.Read(entryCount))
+    {
+        TC_LOG_INFO("sql.driver", "Query result snapshot {} has an unsupported format, recording a new one.", _path);
+        return false;
+    }
+
+    if (version != _version)
+    {
+        TC_LOG_INFO("sql.driver", "Query result snapshot {} was made for another database version, recording a new one.", _path);
+        return false;
+    }
+
+    for (uint32 i = 0; i < entryCount; ++i)
+    {
+        std::string_view sql;
+        if (!reader.ReadString(sql))
+            break;
+
+        char const* entry = reader.GetPosition();
+        if (!ValidateEntry(reader))
+            break;
+
+        _entries[sql] = entry;
+    }
+
+    if (_entries.size() != entryCount)
+    {
+        TC_LOG_ERROR("sql.driver", "Query result snapshot {} is damaged, recording a new one.", _path);
+        _entries.clear();
+        return false;
+    }
+
+    _mapping = std::move(mapping);
+    return true;
+}
+
+void QueryResultSnapshot::StartRecording()
+{
+    _output.open(_path + ".tmp", std::ios::binary | std::ios::trunc);
+    if (!_output)
+    {
+        TC_LOG_ERROR("sql.driver", "Could not create query result snapshot {}.tmp, queries will not be recorded.", _path);
+        return;
+    }
+
+    std::string header;
+    Append(header, SnapshotMagic);
+    Append(header, SnapshotFormatVersion);
+    AppendString(header, _version.c_str(), _version.length());
+    _entryCountOffset = header.size();
+    Append(header, uint32(0));
+    _output.write(header.data(), header.size());
+
+    _state = State::Recording;
+    TC_LOG_INFO("sql.driver", "Recording query results into snapshot {}.", _path);
+}
+
+bool QueryResultSnapshot::Find(std::string_view sql, ResultSet** result)
+{
+    // after a write the stored results may no longer match the database
+    if (_state != State::Reading || _invalidated)
+        return false;
+
+    auto itr = _entries.find(sql);
+    if (itr == _entries.end())
+    {
+        ++_misses;
+        TC_LOG_DEBUG("sql.driver", "Query not found in snapshot {}: {}", _path, sql);
+        return false;
+    }
+
+    ++_hits;
+    *result = CreateResultSet(itr->second, _mapping);
+    return true;
+}
+
+ResultSet* QueryResultSnapshot::Record(std::string_view sql, ResultSet* result)
+{
+    if (_state != State::Recording || _invalidated)
+        return result;
+
+    std::shared_ptr<std::string> entry = std::make_shared<std::string>();
+    AppendString(*entry, sql.data(), sql.length());
+    std::size_t const sqlSize = entry->size();
+
+    uint32 const fieldCount = result ? result->GetFieldCount() : 0;
+    Append(*entry, fieldCount);
+    Append(*entry, uint64(result ? result->GetRowCount() : 0));
+
+    // field descriptions are released together with the mysql result, store them before fetching rows
+    for (uint32 i = 0; i < fieldCount; ++i)
+    {
+        MySQLField const& field = result->_fields[i];
+        Append(*entry, uint32(field.type));
+        Append(*entry, uint32(field.flags));
+        AppendString(*entry, field.org_table);
+        AppendString(*entry, field.table);
+        AppendString(*entry, field.org_name);
+        AppendString(*entry, field.name);
+    }
+
+    std::size_t const rowDataSizeOffset = entry->size();
+    Append(*entry, uint64(0));
+
+    uint64 rowCount = 0;
+    while (result && result->NextRow())
+    {
+        Field const* row = result->Fetch();
+        for (uint32 i = 0; i < fieldCount; ++i)
+        {
+            if (row[i].IsNull())
+                Append(*entry, NullValueLength);
+            else
+                AppendString(*entry, row[i]._value, row[i]._length);
+        }
+
+        ++rowCount;
+    }
+
+    delete result;
+
+    uint64 const rowDataSize = entry->size() - rowDataSizeOffset - sizeof(uint64);
+    memcpy(entry->data() + rowDataSizeOffset, &rowDataSize, sizeof(uint64));
+    memcpy(entry->data() + sqlSize + sizeof(uint32), &rowCount, sizeof(uint64));
+
+    {
+        std::lock_guard<std::mutex> lock(_outputLock);
+        if (_state == State::Recording && !_invalidated)
+        {
+            _output.write(entry->data(), entry->size());
+            ++_recordedEntries;
+        }
+    }
+
+    char const* fields = entry->data() + sqlSize;
+    return CreateResultSet(fields, std::move(entry));
+}
+
+ResultSet* QueryResultSnapshot::CreateResultSet(char const* entry, std::shared_ptr<void const> storage) const
+{
+    // entries were validated when loaded or just written
+    SnapshotReader reader(entry, nullptr);
+    uint32 fieldCount;
+    uint64 rowCount;
+    reader.Read(fieldCount);
+    reader.Read(rowCount);
+    if (!rowCount)
+        return nullptr;
+
+    // kept with the result so it can be recorded again like results from the server
+    std::shared_ptr<SnapshotResultStorage> resultStorage = std::make_shared<SnapshotResultStorage>();
+    resultStorage->Fields.resize(fieldCount);
+    resultStorage->Entry = std::move(storage);
+    for (MySQLField& field : resultStorage->Fields)
+    {
+        uint32 type, flags;
+        std::string_view table, tableAlias, name, alias;
+        reader.Read(type);
+        reader.Read(flags);
+        reader.ReadString(table);
+        reader.ReadString(tableAlias);
+        reader.ReadString(name);
+        reader.ReadString(alias);
+
+        field.type = enum_field_types(type);
+        field.flags = flags;
+        field.org_table = const_cast<char*>(table.data());
+        field.table = const_cast<char*>(tableAlias.data());
+        field.org_name = const_cast<char*>(name.data());
+        field.name = const_cast<char*>(alias.data());
+    }
+
+    uint64 rowDataSize;
+    reader.Read(rowDataSize);
+
+    MySQLField* fields = resultStorage->Fields.data();
+    return new ResultSet(fields, rowCount, fieldCount, reader.GetPosition(), std::move(resultStorage));
+}
+
+char const* QueryResultSnapshot::ReadRow(char const* data, Field* row, uint32 fieldCount)
+{
+    for (uint32 i = 0; i < fieldCount; ++i)
+    {
+        uint32 length;
+        memcpy(&length, data, sizeof(length));
+        data += sizeof(length);
+
+        if (length == NullValueLength)
+            row[i].SetValue(nullptr, 0);
+        else
+        {
+            row[i].SetValue(data, length);
+            data += length + 1;
+        }
+    }
+
+    return data;
+}
+
+void QueryResultSnapshot::Invalidate()
+{
+    if (_invalidated.exchange(true))
+        return;
+
+    if (_state == State::Closed)
+        RemoveFile(_path);
+
+    TC_LOG_INFO("sql.driver", "Database was written to, discarding query result snapshot {}.", _path);
+}
+
+void QueryResultSnapshot::Close()
+{
+    State const state = _state.exchange(State::Closed);
+    if (state == State::Recording)
+    {
+        std::lock_guard<std::mutex> lock(_outputLock);
+        if (!_invalidated)
+        {
+            _output.seekp(_entryCountOffset);
+            _output.write(reinterpret_cast<char const*>(&_recordedEntries), sizeof(_recordedEntries));
+        }
+
+        _output.close();
+
+        boost::system::error_code error;
+        if (!_invalidated && !_output.fail())
+        {
+            boost::filesystem::rename(_path + ".tmp", _path, error);
+            if (!error)
+                TC_LOG_INFO("sql.driver", "Saved {} query results to snapshot {}.", _recordedEntries, _path);
+            else
+                TC_LOG_ERROR("sql.driver", "Could not save query result snapshot {}: {}", _path, error.message());
+        }
+        else
+            RemoveFile(_path + ".tmp");
+    }
+    else if (state == State::Reading)
+    {
+        TC_LOG_INFO("sql.driver", ">> Answered {} queries from snapshot {}, {} were not part of it.", uint32(_hits), _path, uint32(_misses));
+
+        _entries.clear();
+        _mapping.reset();
+
+        // incomplete snapshots are recorded again on the next start
+        if (_invalidated || _misses)
+            RemoveFile(_path);
+    }
+}
+
+void QueryResultSnapshot::RemoveFile(std::string const& path) const
+{
+    boost::system::error_code error;
+    boost::filesystem::remove(path, error);
+}
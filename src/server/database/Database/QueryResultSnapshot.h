@@ -0,0 +1,107 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_QUERY_RESULT_SNAPSHOT_H
+#define TRINITY_QUERY_RESULT_SNAPSHOT_H
+
+#include "Define.h"
+#include "DatabaseEnvFwd.h"
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace boost
+{
+    namespace iostreams
+    {
+        class mapped_file_source;
+    }
+}
+
+/**
+    @class QueryResultSnapshot
+
+    @brief Binary copy of string query results, memory mapped to answer the same queries on the next start
+
+    When no snapshot made for the requested version exists, every result passed to Record is written to a new file
+    that replaces the old one on Close. Values are stored as returned by the text protocol so results read back
+    from the snapshot go through the same conversions as results coming from the server.
+    Once invalidated (the database was written to) the snapshot stops answering queries and its file is removed.
+*/
+class TC_DATABASE_API QueryResultSnapshot
+{
+    public:
+        QueryResultSnapshot(std::string path, std::string version);
+        ~QueryResultSnapshot();
+
+        bool IsLoaded() const { return _state == State::Reading; }
+
+        //! Returns true if the query is stored in the loaded snapshot, result is set to nullptr for queries without rows.
+        bool Find(std::string_view sql, ResultSet** result);
+
+        //! Stores the result of a query that wasn't found and returns an equivalent result set, takes ownership of result.
+        //! Pass nullptr for successful queries without rows.
+        ResultSet* Record(std::string_view sql, ResultSet* result);
+
+        //! Called on every write to the database.
+        void Invalidate();
+
+        //! Stops answering and recording queries, saves a recorded snapshot unless it was invalidated in the meantime.
+        void Close();
+
+        //! Sets the values of one row and returns the start of the next one.
+        static char const* ReadRow(char const* data, Field* row, uint32 fieldCount);
+
+    private:
+        enum class State : uint8
+        {
+            Reading,
+            Recording,
+            Closed
+        };
+
+        bool Load();
+        void StartRecording();
+        ResultSet* CreateResultSet(char const* entry, std::shared_ptr<void const> storage) const;
+        void RemoveFile(std::string const& path) const;
+
+        std::string _path;
+        std::string _version;
+        std::atomic<State> _state;
+        std::atomic<bool> _invalidated;
+
+        // Reading
+        std::shared_ptr<boost::iostreams::mapped_file_source> _mapping;
+        std::unordered_map<std::string_view, char const*> _entries;
+        std::atomic<uint32> _hits;
+        std::atomic<uint32> _misses;
+
+        // Recording
+        std::mutex _outputLock;
+        std::ofstream _output;
+        std::streamoff _entryCountOffset;
+        uint32 _recordedEntries;
+
+        QueryResultSnapshot(QueryResultSnapshot const& right) = delete;
+        QueryResultSnapshot& operator=(QueryResultSnapshot const& right) = delete;
+};
+
+#endif // TRINITY_QUERY_RESULT_SNAPSHOT_H
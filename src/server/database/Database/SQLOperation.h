@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include "PacketBufferPool.h"
 
 //- Union that holds element data
 union SQLElementUnion
@@ -58,6 +59,13 @@ class TC_DATABASE_API SQLOperation
         virtual bool Execute() = 0;
         virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
+        //! One-way statements that workers may execute in one transaction with other statements queued right after them
+        virtual bool CanBatch() const { return false; }
+
+        // Operations are created by every thread using the database and destroyed by workers, keep them in the shared size class pool
+        static void* operator new(std::size_t size) { return Trinity::PacketBufferPool::Allocate(size); }
+        static void operator delete(void* block, std::size_t size) noexcept { Trinity::PacketBufferPool::Deallocate(block, size); }
+
         MySQLConnection* m_conn;
 
     private:
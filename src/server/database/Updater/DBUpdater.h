@@ -84,6 +84,9 @@ public:
 
     static bool Populate(DatabaseWorkerPool<T>& pool);
 
+    /// Hash of all applied updates, changes whenever an update is applied or rehashed
+    static std::string GetAppliedUpdatesHash(DatabaseWorkerPool<T>& pool);
+
 private:
     static QueryResult Retrieve(DatabaseWorkerPool<T>& pool, std::string const& query);
     static void Apply(DatabaseWorkerPool<T>& pool, std::string const& query);
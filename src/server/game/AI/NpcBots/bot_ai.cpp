@@ -10,6 +10,8 @@
 #include "botdatamgr.h"
 #include "botlog.h"
 #include "botmgr.h"
+#include "botnearbyunits.h"
+#include "botpathplanner.h"
 #include "botgearscore.h"
 #include "botgossip.h"
 #include "botspell.h"
@@ -244,9 +246,7 @@ bot_ai::bot_ai(Creature* creature) : CreatureAI(creature),
 
     shouldEnterVehicle = false;
 
-    _saveDisabledSpellsTimer = 0;
     _saveDisabledSpells = false;
-    _saveMiscValuesTimer = 0;
     _saveMiscValues = false;
 
     _deathsCount = 0;
@@ -285,6 +285,11 @@ bot_ai::bot_ai(Creature* creature) : CreatureAI(creature),
     _baseLevel = 0;
     _travel_node_last = nullptr;
     _travel_node_cur = nullptr;
+    _travel_route_index = 0;
+    _travel_route_complete = false;
+    _unobservedDiff = 0;
+    _observedCheckTimer = 0;
+    _observed = true;
 
     _groupUpdateMask = 0;
     _auraRaidUpdateMask = 0;
@@ -2332,8 +2337,13 @@ void bot_ai::SetStats(bool force)
     {
         if (_baseLevel == 0) //this only happens once
         {
-            mylevel = urand(me->GetCreatureTemplate()->minlevel, me->GetCreatureTemplate()->maxlevel);
-            mylevel += BotDataMgr::GetLevelBonusForBotRank(me->GetCreatureTemplate()->rank);
+            if (WanderingBotSpawnPrep const* prep = BotDataMgr::GetWanderingBotSpawnPrep(me->GetEntry()))
+                mylevel = prep->baseLevel;
+            else
+            {
+                mylevel = urand(me->GetCreatureTemplate()->minlevel, me->GetCreatureTemplate()->maxlevel);
+                mylevel += BotDataMgr::GetLevelBonusForBotRank(me->GetCreatureTemplate()->rank);
+            }
             _baseLevel = std::max<uint8>(mylevel, BotDataMgr::GetMinLevelForBotClass(_botclass));
             if (me->GetMap()->IsBattlegroundOrArena())
                 BOT_LOG_DEBUG("npcbots", "BG bot {} id {} selected level {}...", me->GetName(), me->GetEntry(), uint32(_baseLevel));
@@ -4040,6 +4050,73 @@ Unit* bot_ai::_getVehicleTarget(BotVehicleStrats /*strat*/) const
 //GETTARGET
 //Returns attack target or 'no target' and distant check target or 'no target'
 //All code above 'x = _getTarget() call must not dereference opponent or disttarget since it can be invalid
+std::vector<Unit*> const* bot_ai::_getNearbyUnitsCache(WorldObject const* center, float dist) const
+{
+    if (IAmFree() || !master->GetBotMgr())
+        return nullptr;
+
+    return master->GetBotMgr()->GetNearbyUnits(me, center, dist);
+}
+template<class Check>
+void bot_ai::_getNearbyUnits(std::list<Unit*>& units, Check& check, float dist, WorldObject const* center, WorldObject const* searcher) const
+{
+    if (!center)
+        center = me;
+    if (!searcher)
+        searcher = me;
+
+    if (std::vector<Unit*> const* cachedUnits = _getNearbyUnitsCache(center, dist))
+    {
+        NPCBots::VisitCachedNearbyUnits(*cachedUnits, me, center, dist, [&](Unit* u) {
+            if (check(u))
+                units.push_back(u);
+            return true;
+        });
+        return;
+    }
+
+    Bcore::UnitListSearcher<Check> usearcher(searcher, units, check);
+    Cell::VisitAllObjects(center, usearcher, dist);
+}
+template<class Check>
+Unit* bot_ai::_getNearbyUnit(Check& check, float dist) const
+{
+    if (std::vector<Unit*> const* cachedUnits = _getNearbyUnitsCache(me, dist))
+    {
+        Unit* unit = nullptr;
+        NPCBots::VisitCachedNearbyUnits(*cachedUnits, me, me, dist, [&](Unit* u) {
+            if (!check(u))
+                return true;
+            unit = u;
+            return false;
+        });
+        return unit;
+    }
+
+    Unit* unit = nullptr;
+    Bcore::UnitSearcher<Check> searcher(me, unit, check);
+    Cell::VisitAllObjects(me, searcher, dist);
+    return unit;
+}
+template<class Check>
+Unit* bot_ai::_getNearbyUnitLast(Check& check, float dist) const
+{
+    Unit* unit = nullptr;
+    if (std::vector<Unit*> const* cachedUnits = _getNearbyUnitsCache(me, dist))
+    {
+        NPCBots::VisitCachedNearbyUnits(*cachedUnits, me, me, dist, [&](Unit* u) {
+            if (check(u))
+                unit = u;
+            return true;
+        });
+        return unit;
+    }
+
+    Bcore::UnitLastSearcher<Check> searcher(me, unit, check);
+    Cell::VisitAllObjects(me, searcher, dist);
+    return unit;
+}
+
 std::tuple<Unit*, Unit*> bot_ai::_getTargets(bool byspell, bool ranged, bool &reset) const
 {
     //if (_evadeMode) //IAmFree() case only
@@ -4613,8 +4690,7 @@ std::tuple<Unit*, Unit*> bot_ai::_getTargets(bool byspell, bool ranged, bool &re
     std::array<std::pair<Unit*, float>, 2u> ts{};
     std::list<Unit*> unitList;
     NearestHostileUnitCheck check(me, maxdist, byspell, this);
-    Bcore::UnitListSearcher searcher(master->ToUnit(), unitList, check);
-    Cell::VisitAllObjects(HasBotCommandState(BOT_COMMAND_STAY) ? me->ToUnit() : master->ToUnit(), searcher, maxdist);
+    _getNearbyUnits(unitList, check, maxdist, HasBotCommandState(BOT_COMMAND_STAY) ? me->ToUnit() : master->ToUnit(), master);
 
     if (IAmFree())
     {
@@ -6543,14 +6619,8 @@ Unit* bot_ai::FindImmunityShieldDispelTarget(float dist) const
     if (me->GetVictim() && me->GetVictim()->HasAuraWithMechanic(1<<MECHANIC_IMMUNE_SHIELD))
         return me->GetVictim();
 
-    Unit* unit = nullptr;
-
     ImmunityShieldDispelTargetCheck check(me, dist, this);
-    Bcore::UnitSearcher <ImmunityShieldDispelTargetCheck> searcher(me, unit, check);
-    Cell::VisitAllObjects(me, searcher, dist);
-    //me->VisitNearbyObject(dist, searcher);
-
-    return unit;
+    return _getNearbyUnit(check, dist);
 }
 //Used to find target for priest's dispels, mage's spellsteal and shaman's purge
 //Returns dispellable/stealable 'Any Hostile Unit Attacking BotParty'
@@ -6559,9 +6629,7 @@ Unit* bot_ai::FindHostileDispelTarget(float dist, bool stealable) const
     std::list<Unit*> unitList;
 
     HostileDispelTargetCheck check(me, dist, stealable, this);
-    Bcore::UnitListSearcher <HostileDispelTargetCheck> searcher(me, unitList, check);
-    Cell::VisitAllObjects(me, searcher, dist);
-    //me->VisitNearbyObject(dist, searcher);
+    _getNearbyUnits(unitList, check, dist);
 
     if (unitList.empty())
         return nullptr;
@@ -6605,9 +6673,7 @@ Unit* bot_ai::FindPolyTarget(float dist) const
     std::list<Unit*> unitList;
 
     PolyUnitCheck check(me, dist);
-    Bcore::UnitListSearcher <PolyUnitCheck> searcher(me, unitList, check);
-    Cell::VisitAllObjects(me, searcher, dist);
-    //me->VisitNearbyObject(dist, searcher);
+    _getNearbyUnits(unitList, check, dist);
 
     if (unitList.empty())
         return nullptr;
@@ -6625,9 +6691,7 @@ Unit* bot_ai::FindFearTarget(float dist) const
     std::list<Unit*> unitList;
 
     FearUnitCheck check(me, dist, this);
-    Bcore::UnitListSearcher <FearUnitCheck> searcher(me, unitList, check);
-    Cell::VisitAllObjects(me, searcher, dist);
-    //me->VisitNearbyObject(dist, searcher);
+    _getNearbyUnits(unitList, check, dist);
 
     if (unitList.empty())
         return nullptr;
@@ -6645,9 +6709,7 @@ Unit* bot_ai::FindStunTarget(float dist) const
     std::list<Unit*> unitList;
 
     StunUnitCheck check(me, dist);
-    Bcore::UnitListSearcher <StunUnitCheck> searcher(me, unitList, check);
-    Cell::VisitAllObjects(me, searcher, dist);
-    //me->VisitNearbyObject(dist, searcher);
+    _getNearbyUnits(unitList, check, dist);
 
     if (unitList.empty())
         return nullptr;
@@ -6668,9 +6730,7 @@ Unit* bot_ai::FindUndeadCCTarget(float dist, uint32 spellId, bool unattacked) co
     std::list<Unit*> unitList;
 
     UndeadCCUnitCheck check(me, dist, this, spellId, unattacked);
-    Bcore::UnitListSearcher <UndeadCCUnitCheck> searcher(me, unitList, check);
-    Cell::VisitAllObjects(me, searcher, dist);
-    //me->VisitNearbyObject(dist, searcher);
+    _getNearbyUnits(unitList, check, dist);
 
     if (unitList.empty())
         return nullptr;
@@ -6691,9 +6751,7 @@ Unit* bot_ai::FindRootTarget(float dist, uint32 spellId) const
     std::list<Unit*> unitList;
 
     RootUnitCheck check(me, dist, this, spellId);
-    Bcore::UnitListSearcher <RootUnitCheck> searcher(me, unitList, check);
-    Cell::VisitAllObjects(me, searcher, dist);
-    //me->VisitNearbyObject(dist, searcher);
+    _getNearbyUnits(unitList, check, dist);
 
     if (unitList.empty())
         return nullptr;
@@ -6712,9 +6770,7 @@ Unit* bot_ai::FindCastingTarget(float maxdist, float mindist, uint32 spellId, ui
     std::list<Unit*> unitList;
 
     CastingUnitCheck check(me, mindist, maxdist, spellId, minHpPct);
-    Bcore::UnitListSearcher <CastingUnitCheck> searcher(me, unitList, check);
-    Cell::VisitAllObjects(me, searcher, maxdist);
-    //me->VisitNearbyObject(maxdist, searcher);
+    _getNearbyUnits(unitList, check, maxdist);
 
     if (unitList.empty())
         return nullptr;
@@ -6796,14 +6852,8 @@ Unit* bot_ai::FindSplashTarget(float dist, Unit* To, float splashdist) const
     if (me->GetDistance(To) > dist)
         return nullptr;
 
-    Unit* unit = nullptr;
-
     SecondEnemyCheck check(me, dist, splashdist, To, this);
-    Bcore::UnitSearcher <SecondEnemyCheck> searcher(me, unit, check);
-    Cell::VisitAllObjects(me, searcher, dist);
-    //me->VisitNearbyObject(dist, searcher);
-
-    return unit;
+    return _getNearbyUnit(check, dist);
 }
 // Finds secondary target for AoE spells like Mind Sear (not damaging primary target)
 Unit* bot_ai::FindSplashTarget(float dist, Unit* To, float splashdist, uint8 minTargets) const
@@ -6817,9 +6867,7 @@ Unit* bot_ai::FindSplashTarget(float dist, Unit* To, float splashdist, uint8 min
     std::list<Unit*> unitList;
 
     SecondEnemyCheck check(me, dist, splashdist, To, this);
-    Bcore::UnitListSearcher <SecondEnemyCheck> searcher(me, unitList, check);
-    Cell::VisitAllObjects(me, searcher, dist);
-    //me->VisitNearbyObject(dist, searcher);
+    _getNearbyUnits(unitList, check, dist);
 
     if (uint8(unitList.size()) < minTargets)
         return nullptr;
@@ -6831,14 +6879,8 @@ Unit* bot_ai::FindSplashTarget(float dist, Unit* To, float splashdist, uint8 min
 //Finds target for hunter's Tranquilizing Shot (has dispellable magic or enrage effect)
 Unit* bot_ai::FindTranquilTarget(float mindist, float maxdist) const
 {
-    Unit* unit = nullptr;
-
     TranquilTargetCheck check(me, mindist, maxdist, this);
-    Bcore::UnitSearcher <TranquilTargetCheck> searcher(me, unit, check);
-    Cell::VisitAllObjects(me, searcher, maxdist);
-    //me->VisitNearbyObject(maxdist, searcher);
-
-    return unit;
+    return _getNearbyUnit(check, maxdist);
 }
 //Find target to cast taunt on
 //In case of paladin's Righetoous Defense returns IsInBotParty() unit
@@ -6847,9 +6889,7 @@ Unit* bot_ai::FindDistantTauntTarget(float maxdist, bool ally) const
     std::list<Unit*> unitList;
 
     FarTauntUnitCheck check(me, maxdist, ally, this);
-    Bcore::UnitListSearcher <FarTauntUnitCheck> searcher(me, unitList, check);
-    Cell::VisitAllObjects(me, searcher, maxdist);
-    //me->VisitNearbyObject(maxdist, searcher);
+    _getNearbyUnits(unitList, check, maxdist);
 
     if (unitList.empty())
         return nullptr;
@@ -6861,14 +6901,8 @@ Unit* bot_ai::FindDistantTauntTarget(float maxdist, bool ally) const
 //Returns nearby CCed unit with most mana
 Unit* bot_ai::FindDrainTarget(float maxdist) const
 {
-    Unit* unit = nullptr;
-
     ManaDrainUnitCheck check(me, maxdist, this);
-    Bcore::UnitLastSearcher <ManaDrainUnitCheck> searcher(me, unit, check);
-    Cell::VisitAllObjects(me, searcher, maxdist);
-    //me->VisitNearbyObject(maxdist, searcher);
-
-    return unit;
+    return _getNearbyUnitLast(check, maxdist);
 }
 //Finds all targets within given range
 //used for finding targets for spells which need reasonable amount of targets (ex. Death Knight AOE spells)
@@ -6881,9 +6915,7 @@ void bot_ai::GetNearbyTargetsList(std::list<Unit*> &targets, float maxdist, uint
         source = me;
 
     NearbyHostileUnitCheck check(me, maxdist, this, CCoption, source);
-    Bcore::UnitListSearcher <NearbyHostileUnitCheck> searcher(me, targets, check);
-    Cell::VisitAllObjects(me, searcher, maxdist);
-    //me->VisitNearbyObject(maxdist, searcher);
+    _getNearbyUnits(targets, check, maxdist);
 }
 //Find all targets within given range in cone in front of caster; angle is PI/2 (TC confirmed)
 //used by mage Dragon's Breath and Cone of Cold spells
@@ -6891,18 +6923,14 @@ void bot_ai::GetNearbyTargetsList(std::list<Unit*> &targets, float maxdist, uint
 void bot_ai::GetNearbyTargetsInConeList(std::list<Unit*> &targets, float maxdist) const
 {
     NearbyHostileUnitInConeCheck check(me, maxdist, this);
-    Bcore::UnitListSearcher <NearbyHostileUnitInConeCheck> searcher(me, targets, check);
-    Cell::VisitAllObjects(me, searcher, maxdist);
-    //me->VisitNearbyObject(maxdist, searcher);
+    _getNearbyUnits(targets, check, maxdist);
 }
 //Finds all friendly targets within given range
 //used for finding targets to heal/buff for uncontrolled bots
 void bot_ai::GetNearbyFriendlyTargetsList(std::list<Unit*> &targets, float maxdist) const
 {
     NearbyFriendlyUnitCheck check(me, maxdist, this);
-    Bcore::UnitListSearcher <NearbyFriendlyUnitCheck> searcher(me, targets, check);
-    Cell::VisitAllObjects(me, searcher, maxdist);
-    //me->VisitNearbyObject(maxdist, searcher);
+    _getNearbyUnits(targets, check, maxdist);
 }
 //////////
 //SPELLMAP
@@ -15338,6 +15366,10 @@ void bot_ai::InitEquips()
     {
         GenerateRand();
         uint8 lvl = me->GetLevel();
+        //gear candidates pre-filtered in background if level roll was not overridden since
+        WanderingBotSpawnPrep const* prep = BotDataMgr::GetWanderingBotSpawnPrep(me->GetEntry());
+        if (prep && prep->gearLevel != lvl)
+            prep = nullptr;
         std::ostringstream gss;
         gss << "bot_ai::InitEquips(): Wanderer bot " << me->GetName() << " id " << me->GetEntry() << ' ' << "level " << uint32(lvl) << " generated gear:";
         for (uint8 i = BOT_SLOT_MAINHAND; i < BOT_INVENTORY_SIZE; ++i)
@@ -15584,7 +15616,7 @@ void bot_ai::InitEquips()
                 }
 
                 return true;
-            });
+            }, prep ? &prep->gear[i] : nullptr);
 
             if (!item)
             {
@@ -15607,6 +15639,7 @@ void bot_ai::InitEquips()
             }
         }
         BOT_LOG_TRACE("npcbots", "{}", gss.str());
+        BotDataMgr::ReleaseWanderingBotSpawnPrep(me->GetEntry());
     }
     else
     {
@@ -16455,8 +16488,11 @@ void bot_ai::UnsummonPet(bool save)
     UnsummonCreature(botPet, save);
 }
 
-void bot_ai::MoveInLineOfSight(Unit* /*u*/)
+void bot_ai::MoveInLineOfSight(Unit* u)
 {
+    //promote unobserved wanderer to full update rate right away
+    if (!_observed && u->IsPlayer())
+        _observed = true;
 }
 
 void bot_ai::AttackStart(Unit* /*u*/)
@@ -17901,6 +17937,9 @@ bool bot_ai::GlobalUpdate(uint32 diff)
     if (!BotMgr::IsNpcBotModEnabled() || !BotDataMgr::AllBotsLoaded())
         return false;
 
+    if (IsWanderer() && !UpdateDetailLevel(diff))
+        return false;
+
     if (IsWanderer())
     {
         if (Battleground* bg = GetBG())
@@ -17933,21 +17972,19 @@ bool bot_ai::GlobalUpdate(uint32 diff)
         }
     }
 
-    //db saves with cd
+    //db saves (written behind by BotDataMgr)
     //  1) disabled spells
-    if (_saveDisabledSpells && _saveDisabledSpellsTimer <= diff)
+    if (_saveDisabledSpells)
     {
         _saveDisabledSpells = false;
-        _saveDisabledSpellsTimer = 5000;
 
         if (!IsTempBot())
             BotDataMgr::UpdateNpcBotData(me->GetEntry(), NPCBOT_UPDATE_DISABLED_SPELLS, &_botData->disabled_spells);
     }
     //  2) miscavalues
-    if (_saveMiscValues && _saveMiscValuesTimer <= diff)
+    if (_saveMiscValues)
     {
         _saveMiscValues = false;
-        _saveMiscValuesTimer = 5000;
 
         if (!IsTempBot())
             BotDataMgr::UpdateNpcBotData(me->GetEntry(), NPCBOT_UPDATE_MISCVALUES, &_botData->miscvalues);
@@ -18718,6 +18755,53 @@ bool bot_ai::GlobalUpdate(uint32 diff)
     return true;
 }
 
+//Level of detail for wandering bots
+//Out of combat wanderers no player can see only think once per NpcBot.WanderingBots.Unobserved.UpdateDelay
+//Skipped time is accumulated and handed to GlobalUpdate as a single diff (cooldowns, regeneration)
+//Movement is not affected, travelling continues through motion master
+bool bot_ai::UpdateDetailLevel(uint32& diff)
+{
+    uint32 delay = BotMgr::GetUnobservedWandererUpdateDelay();
+    if (delay && BotMgr::IsWanderingWorldBot(me) && me->IsInWorld())
+    {
+        if (_observedCheckTimer <= diff)
+        {
+            _observedCheckTimer = urand(2000, 3000);
+            _observed = IsObservedByPlayer();
+        }
+        else
+            _observedCheckTimer -= diff;
+
+        if (!_observed && me->IsAlive() && !me->IsInCombat() && !me->GetVictim() && !IsCasting())
+        {
+            _unobservedDiff += diff;
+            if (_unobservedDiff < delay)
+                return false;
+
+            diff = std::exchange(_unobservedDiff, 0);
+            return true;
+        }
+    }
+    else
+        _observed = true;
+
+    //just promoted, hand over the time skipped so far
+    diff += std::exchange(_unobservedDiff, 0);
+    return true;
+}
+
+bool bot_ai::IsObservedByPlayer() const
+{
+    float visDist = me->GetMap()->GetVisibilityRange();
+    for (MapReference const& ref : me->GetMap()->GetPlayers())
+    {
+        Player const* player = ref.GetSource();
+        if (player && player->IsInWorld() && me->IsWithinDist(player, visDist, false))
+            return true;
+    }
+    return false;
+}
+
 void bot_ai::CommonTimers(uint32 diff)
 {
     Events.Update(diff);
@@ -18775,9 +18859,6 @@ void bot_ai::CommonTimers(uint32 diff)
     if (_updateTimerLong > diff)    _updateTimerLong -= diff;
     if (_updateTimerEx1 > diff)     _updateTimerEx1 -= diff;
     if (_updateTimerEx2 > diff)     _updateTimerEx2 -= diff;
-
-    if (_saveDisabledSpellsTimer > diff) _saveDisabledSpellsTimer -= diff;
-    if (_saveMiscValuesTimer > diff)     _saveMiscValuesTimer -= diff;
 }
 
 void bot_ai::UpdateReviveTimer(uint32 diff)
@@ -18932,6 +19013,8 @@ void bot_ai::Evade()
                         !(_travel_node_cur && _travel_node_last &&
                             _travel_node_cur->HasFlag(BotWPFlags::BOTWP_FLAG_MOVEMENT_IGNORES_PATHING) &&
                             _travel_node_last->HasFlag(BotWPFlags::BOTWP_FLAG_MOVEMENT_IGNORES_PATHING));
+                    if (use_path && IsWanderer())
+                        GetNextTravelRoutePoint(pos);
                     GetNextEvadeMovePoint(pos, use_path);
                     if (pos.m_positionZ <= INVALID_HEIGHT)
                     {
@@ -19014,6 +19097,46 @@ void bot_ai::Evade()
     me->SetFacingTo(pos.GetOrientation());
     me->SetFaction(me->GetCreatureTemplate()->faction);
 }
+//replaces pos with next point of planned route to it, planning once per destination
+bool bot_ai::GetNextTravelRoutePoint(Position& pos)
+{
+    static constexpr float ROUTE_POINT_REACHED_DIST = 15.0f;
+    static constexpr float ROUTE_POINT_LOST_DIST = 400.0f;
+
+    if (!me->GetMap()->GetEntry()->IsContinent())
+        return false;
+
+    bool replan = _travel_route_dest.GetExactDist2d(pos) > 1.0f;
+    if (!replan)
+    {
+        while (_travel_route_index < _travel_route.size() && me->GetExactDist2d(_travel_route[_travel_route_index]) < ROUTE_POINT_REACHED_DIST)
+            ++_travel_route_index;
+
+        //ran out of partial route or knocked off it (combat, fear, etc.)
+        if (_travel_route_index >= _travel_route.size())
+            replan = !_travel_route_complete && !_travel_route.empty();
+        else
+            replan = me->GetExactDist2d(_travel_route[_travel_route_index]) > ROUTE_POINT_LOST_DIST;
+    }
+
+    if (replan)
+    {
+        _travel_route_dest.Relocate(pos);
+        _travel_route_index = 0;
+        if (!BotPathPlanner::PlanRoute(me, pos, _travel_route, _travel_route_complete))
+        {
+            _travel_route.clear();
+            _travel_route_complete = true;
+        }
+    }
+
+    if (_travel_route_index >= _travel_route.size())
+        return false;
+
+    pos.Relocate(_travel_route[_travel_route_index]);
+    return true;
+}
+
 void bot_ai::GetNextEvadeMovePoint(Position& pos, bool& use_path) const
 {
     //const uint8 evade_jump_threshold = me->HasUnitMovementFlag(MOVEMENTFLAG_SWIMMING) ? 50 : 25;
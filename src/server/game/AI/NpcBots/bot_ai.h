@@ -115,6 +115,7 @@ class bot_ai : public CreatureAI
 
         void Evade();
         void GetNextEvadeMovePoint(Position& pos, bool& use_path) const;
+        bool GetNextTravelRoutePoint(Position& pos);
 
         EventProcessor* GetEvents() { return &Events; }
         ObjectGuid::LowType GetBotOwnerGuid() const { return _ownerGuid; }
@@ -591,6 +592,8 @@ class bot_ai : public CreatureAI
     private:
         void FindMaster();
         uint32 CalculateOwnershipCheckTime();
+        bool UpdateDetailLevel(uint32& diff);
+        bool IsObservedByPlayer() const;
 
         void _OnHealthUpdate() const;
         void _OnManaUpdate() const;
@@ -658,6 +661,14 @@ class bot_ai : public CreatureAI
         void _castBotItemUseSpell(Item const* item, SpellCastTargets const& targets/*, uint8 cast_count = 0, uint32 glyphIndex = 0*/);
 
         std::tuple<Unit*, Unit*> _getTargets(bool byspell, bool ranged, bool &reset) const;
+        //nearby unit searches, served from owner's shared per-tick unit list when possible (see BotMgr::GetNearbyUnits)
+        std::vector<Unit*> const* _getNearbyUnitsCache(WorldObject const* center, float dist) const;
+        template<class Check>
+        void _getNearbyUnits(std::list<Unit*>& units, Check& check, float dist, WorldObject const* center = nullptr, WorldObject const* searcher = nullptr) const;
+        template<class Check>
+        Unit* _getNearbyUnit(Check& check, float dist) const;
+        template<class Check>
+        Unit* _getNearbyUnitLast(Check& check, float dist) const;
         Unit* _getVehicleTarget(BotVehicleStrats strat) const;
         void _listAuras(Player const* player, Unit const* unit) const;
         bool _checkImmunities(Unit const* target, SpellInfo const* spellInfo) const;
@@ -722,9 +733,6 @@ class bot_ai : public CreatureAI
         uint32 outdoorsTimer;
         uint32 _contestedPvPTimer;
         uint32 _groupUpdateTimer;
-        //save timers
-        uint32 _saveDisabledSpellsTimer;
-        uint32 _saveMiscValuesTimer;
 
         uint32 _lastZoneId, _lastAreaId, _lastWMOAreaId;
         uint32 _selfrez_spell_id;
@@ -749,6 +757,14 @@ class bot_ai : public CreatureAI
         uint8 _baseLevel;
         WanderNode const* _travel_node_last;
         WanderNode const* _travel_node_cur;
+        //long distance route to current travel destination (see BotPathPlanner)
+        std::vector<Position> _travel_route;
+        Position _travel_route_dest;
+        uint32 _travel_route_index;
+        bool _travel_route_complete;
+        uint32 _unobservedDiff;
+        uint32 _observedCheckTimer;
+        bool _observed;
 
         uint32 _groupUpdateMask;
         uint64 _auraRaidUpdateMask;
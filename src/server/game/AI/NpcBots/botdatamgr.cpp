@@ -23,9 +23,12 @@
 #include "SpellInfo.h"
 #include "SpellMgr.h"
 #include "StringConvert.h"
+#include "ThreadPool.h"
 #include "World.h"
 #include "WorldDatabase.h"
 
+#include <deque>
+#include <mutex>
 #include <numeric>
 /*
 Npc Bot Data Manager by Trickerer (onlysuffering@gmail.com)
@@ -50,6 +53,21 @@ NpcBotExtrasMap _botsExtras;
 NpcBotTransmogDataMap _botsTransmogData;
 NpcBotRegistry _existingBots;
 
+//lookup indexes over _existingBots, maintained by RegisterBot/UnregisterBot under BotDataMgr::GetLock()
+typedef std::unordered_map<uint32 /*entry*/, Creature const*> NpcBotEntryIndex;
+typedef std::unordered_map<uint32 /*owner*/, NpcBotRegistry> NpcBotOwnerIndex;
+typedef std::unordered_multimap<std::wstring /*lowercase name*/, Creature const*> NpcBotNameIndex;
+struct NpcBotRegistryKeys
+{
+    uint32 owner;
+    std::array<std::wstring, TOTAL_LOCALES> names;
+};
+NpcBotEntryIndex _existingBotsByEntry;
+NpcBotOwnerIndex _existingBotsByOwner;
+std::array<NpcBotNameIndex, TOTAL_LOCALES> _existingBotsByName;
+std::unordered_map<Creature const*, NpcBotRegistryKeys> _existingBotsKeys;
+uint32 _existingBotsDuplicateEntries = 0; //registered bots not in _existingBotsByEntry because their entry was taken
+
 std::map<uint32, uint8> _wpMinSpawnLevelPerMapId;
 std::map<uint32, uint8> _wpMaxSpawnLevelPerMapId;
 std::map<uint8, std::set<uint32>> _spareBotIdsPerClassMap;
@@ -67,11 +85,132 @@ BotGearSetStorageMap _botStoredGearSetMap;
 
 static bool allBotsLoaded = false;
 
-static uint32 next_wandering_bot_spawn_delay = 0;
+//roles, spec, faction, disabled spells and misc values are written behind, all bots changed since last save in one transaction
+static constexpr uint32 NPCBOT_DATA_SAVE_INTERVAL = 5000;
+static uint32 npcbot_data_save_timer = NPCBOT_DATA_SAVE_INTERVAL;
+static std::set<uint32> _botsDataDirty;
+static std::mutex _botsDataDirtyLock;
+
+//queued wandering bots are prepared by a worker pool, world thread only adds them to map
+struct WanderingBotSpawnBundle
+{
+    uint32 entry;
+    uint8 botclass;
+    WanderNode const* spawnLoc;
+    CreatureTemplate* bot_template;
+    std::unique_ptr<WanderingBotSpawnPrep> prep;
+};
+static std::unique_ptr<Trinity::ThreadPool> _botsWanderSpawnPool;
+static std::deque<WanderingBotSpawnBundle> _botsWanderSpawnBundlesReady;
+static std::mutex _botsWanderSpawnBundlesLock;
+static std::unordered_map<uint32 /*entry*/, std::unique_ptr<WanderingBotSpawnPrep>> _botsWanderSpawnPreps;
+static std::mutex _botsWanderSpawnPrepsLock;
 
 static EventProcessor botSpawnEvents;
 static std::unordered_map<ObjectGuid, EventProcessor> botBGJoinEvents;
 
+static bool NormalizeBotName(std::string_view name, std::wstring& wname)
+{
+    if (!Utf8toWStr(name, wname))
+        return false;
+
+    wstrToLower(wname);
+    return true;
+}
+static void IndexBotOwner(Creature const* bot, uint32 owner)
+{
+    _existingBotsKeys[bot].owner = owner;
+    _existingBotsByOwner[owner].insert(bot);
+}
+static void UnindexBotOwner(Creature const* bot)
+{
+    NpcBotOwnerIndex::iterator itr = _existingBotsByOwner.find(_existingBotsKeys[bot].owner);
+    if (itr == _existingBotsByOwner.end())
+        return;
+
+    itr->second.erase(bot);
+    if (itr->second.empty())
+        _existingBotsByOwner.erase(itr);
+}
+static void IndexBotNames(Creature const* bot)
+{
+    CreatureLocale const* creatureInfo = sObjectMgr->GetCreatureLocale(bot->GetEntry());
+    std::array<std::wstring, TOTAL_LOCALES>& names = _existingBotsKeys[bot].names;
+    for (uint8 loc = LOCALE_enUS; loc != TOTAL_LOCALES; ++loc)
+    {
+        std::string_view basename = bot->GetName();
+        if (creatureInfo && creatureInfo->Name.size() > loc && !creatureInfo->Name[loc].empty())
+            basename = creatureInfo->Name[loc];
+
+        if (NormalizeBotName(basename, names[loc]))
+            _existingBotsByName[loc].emplace(names[loc], bot);
+    }
+}
+static void UnindexBotNames(Creature const* bot)
+{
+    std::array<std::wstring, TOTAL_LOCALES> const& names = _existingBotsKeys[bot].names;
+    for (uint8 loc = LOCALE_enUS; loc != TOTAL_LOCALES; ++loc)
+    {
+        auto [first, last] = _existingBotsByName[loc].equal_range(names[loc]);
+        for (NpcBotNameIndex::iterator itr = first; itr != last; ++itr)
+        {
+            if (itr->second == bot)
+            {
+                _existingBotsByName[loc].erase(itr);
+                break;
+            }
+        }
+    }
+}
+
+static void MarkNpcBotDataDirty(uint32 entry)
+{
+    std::lock_guard<std::mutex> lock(_botsDataDirtyLock);
+    _botsDataDirty.insert(entry);
+}
+static void SaveDirtyNpcBotData()
+{
+    std::set<uint32> dirty;
+    {
+        std::lock_guard<std::mutex> lock(_botsDataDirtyLock);
+        dirty.swap(_botsDataDirty);
+    }
+
+    if (dirty.empty())
+        return;
+
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    for (uint32 entry : dirty)
+    {
+        NpcBotDataMap::const_iterator ci = _botsData.find(entry);
+        if (ci == _botsData.cend())
+            continue;
+
+        NpcBotData const* botData = ci->second;
+
+        std::ostringstream sss;
+        for (uint32 spellId : botData->disabled_spells)
+            sss << spellId << ' ';
+
+        std::ostringstream mss;
+        for (NpcBotData::MiscValuesContainer::value_type const& kv : botData->miscvalues)
+            mss << kv.first << ':' << kv.second << ' ';
+
+        CharacterDatabasePreparedStatement* bstmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_NPCBOT_DATA);
+        //"UPDATE characters_npcbot SET roles = ?, spec = ?, faction = ?, spells_disabled = ?, miscvalues = ? WHERE entry = ?", CONNECTION_ASYNC
+        bstmt->setUInt32(0, botData->roles);
+        bstmt->setUInt8(1, botData->spec);
+        bstmt->setUInt32(2, botData->faction);
+        bstmt->setString(3, sss.str());
+        bstmt->setString(4, mss.str());
+        bstmt->setUInt32(5, entry);
+        trans->Append(bstmt);
+    }
+
+    if (trans->GetSize() > 0)
+        CharacterDatabase.CommitTransaction(trans);
+}
+
 bool BotBankItemCompare::operator()(Item const* item1, Item const* item2) const
 {
     ItemTemplate const* proto1 = item1->GetTemplate();
@@ -183,6 +322,52 @@ public:
     void Abort(uint64 /*e_time*/) override { AbortMe(); }
 };
 
+static ItemIdVector const& GetWanderingBotGearBucket(uint8 slot, uint8 botclass, uint8 level)
+{
+    uint8 lvl = level;
+    ItemIdVector const* itemIdVec = &_botsWanderCreaturesSortedGear[botclass][slot][lvl / ITEM_SORTING_LEVEL_STEP];
+
+    while (itemIdVec->empty() && lvl > ITEM_SORTING_LEVEL_STEP)
+    {
+        lvl -= ITEM_SORTING_LEVEL_STEP;
+        itemIdVec = &_botsWanderCreaturesSortedGear[botclass][slot][lvl / ITEM_SORTING_LEVEL_STEP];
+    }
+
+    return *itemIdVec;
+}
+
+//Runs in spawn pool thread: only reads immutable item / locale data and the bundle's own template
+static void PrepareWanderingBotSpawn(WanderingBotSpawnBundle& bundle)
+{
+    CreatureTemplate& bot_template = *bundle.bot_template;
+    bot_template.InitializeQueryData();
+
+    //same roll as bot_ai::SetStats() does at first spawn
+    WanderingBotSpawnPrep* prep = new WanderingBotSpawnPrep();
+    uint8 level = urand(bot_template.minlevel, bot_template.maxlevel);
+    level += BotDataMgr::GetLevelBonusForBotRank(bot_template.rank);
+    prep->baseLevel = std::max<uint8>(level, BotDataMgr::GetMinLevelForBotClass(bundle.botclass));
+    prep->gearLevel = std::max<uint8>(std::min<uint8>(prep->baseLevel, DEFAULT_MAX_LEVEL + 3), BotDataMgr::GetMinLevelForBotClass(bundle.botclass));
+
+    for (uint8 slot = BOT_SLOT_MAINHAND; slot < BOT_INVENTORY_SIZE; ++slot)
+    {
+        ItemIdVector const& itemIdVec = GetWanderingBotGearBucket(slot, bundle.botclass, prep->gearLevel);
+        ItemIdVector& candidates = prep->gear[slot];
+        candidates.reserve(itemIdVec.size());
+        for (uint32 iid : itemIdVec)
+        {
+            ItemTemplate const* proto = sObjectMgr->GetItemTemplate(iid);
+            if (proto->RequiredLevel > prep->gearLevel)
+                continue;
+            if (bundle.botclass < BOT_CLASS_EX_START && !(proto->AllowableClass & (1 << (bundle.botclass - 1))))
+                continue;
+            candidates.push_back(iid);
+        }
+    }
+
+    bundle.prep.reset(prep);
+}
+
 static void SpawnWandererBot(uint32 bot_id, WanderNode const* spawnLoc, NpcBotRegistry* registry)
 {
     CreatureTemplate const& bot_template = _botsWanderCreatureTemplates.at(bot_id);
@@ -363,7 +548,9 @@ private:
             }
         }
 
-        bot_template.InitializeQueryData();
+        //queued bots build query data in background (PrepareWanderingBotSpawn)
+        if (immediate)
+            bot_template.InitializeQueryData();
 
         uint8 bot_spec = bot_ai::SelectSpecForClass(bot_class);
         NpcBotData* bot_data = new NpcBotData(bot_ai::DefaultRolesForClass(bot_class, bot_spec), bot_faction, bot_spec);
@@ -625,6 +812,15 @@ public:
 
 void BotDataMgr::Update(uint32 diff)
 {
+    if (npcbot_data_save_timer <= diff)
+    {
+        npcbot_data_save_timer = NPCBOT_DATA_SAVE_INTERVAL;
+        SaveDirtyNpcBotData();
+        BotLogger::Flush();
+    }
+    else
+        npcbot_data_save_timer -= diff;
+
     botSpawnEvents.Update(diff);
     for (auto& kv : botBGJoinEvents)
         kv.second.Update(diff);
@@ -687,6 +883,7 @@ void BotDataMgr::Update(uint32 diff)
             }
             _botsWanderCreatureEquipmentTemplates.erase(bwcetitr);
             _botsWanderCreatureTemplates.erase(bwctitr);
+            ReleaseWanderingBotSpawnPrep(bot_despawn_id);
 
             BOT_LOG_DEBUG("npcbots", "Despawned wanderer bot {} '{}' (orig {})", bot_despawn_id, botName, origEntry);
         }
@@ -694,25 +891,55 @@ void BotDataMgr::Update(uint32 diff)
 
     if (!_botsWanderCreaturesToSpawn.empty())
     {
-        static const uint32 WANDERING_BOT_SPAWN_DELAY = 500;
+        if (!_botsWanderSpawnPool && BotMgr::GetWanderingBotsSpawnThreads())
+            _botsWanderSpawnPool = std::make_unique<Trinity::ThreadPool>(BotMgr::GetWanderingBotsSpawnThreads());
 
-        next_wandering_bot_spawn_delay += diff;
+        BOT_LOG_DEBUG("npcbots", "Bots to prepare for spawn: {}", uint32(_botsWanderCreaturesToSpawn.size()));
 
-        while (next_wandering_bot_spawn_delay >= WANDERING_BOT_SPAWN_DELAY && !_botsWanderCreaturesToSpawn.empty())
+        while (!_botsWanderCreaturesToSpawn.empty())
         {
-            next_wandering_bot_spawn_delay -= WANDERING_BOT_SPAWN_DELAY;
-
             auto const& p = _botsWanderCreaturesToSpawn.front();
 
-            uint32 bot_id = p.first;
-            WanderNode const* spawnLoc = p.second;
+            WanderingBotSpawnBundle bundle;
+            bundle.entry = p.first;
+            bundle.botclass = ASSERT_NOTNULL(SelectNpcBotExtras(p.first))->bclass;
+            bundle.spawnLoc = p.second;
+            bundle.bot_template = &_botsWanderCreatureTemplates.at(p.first);
 
             _botsWanderCreaturesToSpawn.pop_front();
 
-            SpawnWandererBot(bot_id, spawnLoc, nullptr);
+            if (_botsWanderSpawnPool)
+            {
+                _botsWanderSpawnPool->PostWork([bundle = std::make_shared<WanderingBotSpawnBundle>(std::move(bundle))]() {
+                    PrepareWanderingBotSpawn(*bundle);
+                    std::lock_guard<std::mutex> lock(_botsWanderSpawnBundlesLock);
+                    _botsWanderSpawnBundlesReady.push_back(std::move(*bundle));
+                });
+            }
+            else
+            {
+                PrepareWanderingBotSpawn(bundle);
+                std::lock_guard<std::mutex> lock(_botsWanderSpawnBundlesLock);
+                _botsWanderSpawnBundlesReady.push_back(std::move(bundle));
+            }
+        }
+    }
+
+    std::unique_lock<std::mutex> bundlesLock(_botsWanderSpawnBundlesLock);
+    for (uint32 placed = 0; placed < BotMgr::GetWanderingBotsSpawnPerUpdate() && !_botsWanderSpawnBundlesReady.empty(); ++placed)
+    {
+        WanderingBotSpawnBundle bundle = std::move(_botsWanderSpawnBundlesReady.front());
+        _botsWanderSpawnBundlesReady.pop_front();
+        bundlesLock.unlock();
+
+        {
+            std::lock_guard<std::mutex> lock(_botsWanderSpawnPrepsLock);
+            _botsWanderSpawnPreps[bundle.entry] = std::move(bundle.prep);
         }
 
-        return;
+        SpawnWandererBot(bundle.entry, bundle.spawnLoc, nullptr);
+
+        bundlesLock.lock();
     }
 }
 
@@ -1653,6 +1880,12 @@ void BotDataMgr::LoadWanderMap(bool reload, bool force_all_maps)
         }
     });
 
+    //battleground bots route towards objectives, continent wanderers pick links at random
+    WanderNode::BuildRoutingTables([](uint32 mapId) {
+        MapEntry const* mapEntry = sMapStore.LookupEntry(mapId);
+        return mapEntry && mapEntry->IsBattleground();
+    });
+
     BOT_LOG_INFO("server.loading", ">> Loaded {} bot wander nodes ({} disabled) on {} maps (total {} tops) in {} ms",
         uint32(WanderNode::GetAllWPsCount()), disabled_nodes, uint32(WanderNode::GetWPMapsCount()), uint32(tops.size()), GetMSTimeDiffToNow(botoldMSTime));
 }
@@ -2343,20 +2576,13 @@ void BotDataMgr::CreateWanderingBotsSortedGear()
     BOT_LOG_INFO("server.loading", ">> Sorted wandering bots gear in {} ms", GetMSTimeDiffToNow(oldMSTime));
 }
 
-Item* BotDataMgr::GenerateWanderingBotItem(uint8 slot, uint8 botclass, uint8 level, std::function<bool(ItemTemplate const*)>&& check)
+Item* BotDataMgr::GenerateWanderingBotItem(uint8 slot, uint8 botclass, uint8 level, std::function<bool(ItemTemplate const*)>&& check, ItemIdVector const* candidates/* = nullptr*/)
 {
     ASSERT(slot < BOT_INVENTORY_SIZE);
     ASSERT(botclass < BOT_CLASS_END);
     ASSERT(level <= DEFAULT_MAX_LEVEL + 4);
 
-    uint8 lvl = level;
-    ItemIdVector const* itemIdVec = &_botsWanderCreaturesSortedGear[botclass][slot][lvl / ITEM_SORTING_LEVEL_STEP];
-
-    while (itemIdVec->empty() && lvl > ITEM_SORTING_LEVEL_STEP)
-    {
-        lvl -= ITEM_SORTING_LEVEL_STEP;
-        itemIdVec = &_botsWanderCreaturesSortedGear[botclass][slot][lvl / ITEM_SORTING_LEVEL_STEP];
-    }
+    ItemIdVector const* itemIdVec = candidates ? candidates : &GetWanderingBotGearBucket(slot, botclass, level);
 
     if (!itemIdVec->empty())
     {
@@ -2602,6 +2828,19 @@ bool BotDataMgr::GenerateWanderingBotItemEnchants(Item* item, uint8 slot, uint8
     return result;
 }
 
+WanderingBotSpawnPrep const* BotDataMgr::GetWanderingBotSpawnPrep(uint32 entry)
+{
+    std::lock_guard<std::mutex> lock(_botsWanderSpawnPrepsLock);
+    auto itr = _botsWanderSpawnPreps.find(entry);
+    return itr == _botsWanderSpawnPreps.cend() ? nullptr : itr->second.get();
+}
+
+void BotDataMgr::ReleaseWanderingBotSpawnPrep(uint32 entry)
+{
+    std::lock_guard<std::mutex> lock(_botsWanderSpawnPrepsLock);
+    _botsWanderSpawnPreps.erase(entry);
+}
+
 CreatureTemplate const* BotDataMgr::GetBotExtraCreatureTemplate(uint32 entry)
 {
     CreatureTemplateContainer::const_iterator cit = _botsWanderCreatureTemplates.find(entry);
@@ -2660,6 +2899,15 @@ void BotDataMgr::UpdateNpcBotData(uint32 entry, NpcBotDataUpdateType updateType,
         {
             if (itr->second->owner == *(uint32*)(data))
                 break;
+            {
+                std::unique_lock<std::shared_mutex> lock(*GetLock());
+                NpcBotEntryIndex::const_iterator eci = _existingBotsByEntry.find(entry);
+                if (eci != _existingBotsByEntry.cend())
+                {
+                    UnindexBotOwner(eci->second);
+                    IndexBotOwner(eci->second, *(uint32*)(data));
+                }
+            }
             itr->second->owner = *(uint32*)(data);
             itr->second->hire_time = itr->second->owner ? uint64(time(0)) : 1ULL;
             bstmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_NPCBOT_OWNER);
@@ -2679,54 +2927,30 @@ void BotDataMgr::UpdateNpcBotData(uint32 entry, NpcBotDataUpdateType updateType,
             break;
         case NPCBOT_UPDATE_ROLES:
             itr->second->roles = *(uint32*)(data);
-            bstmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_NPCBOT_ROLES);
-            //"UPDATE character_npcbot SET roles = ? WHERE entry = ?", CONNECTION_ASYNC
-            bstmt->setUInt32(0, itr->second->roles);
-            bstmt->setUInt32(1, entry);
-            CharacterDatabase.Execute(bstmt);
+            MarkNpcBotDataDirty(entry);
             break;
         case NPCBOT_UPDATE_SPEC:
             itr->second->spec = *(uint8*)(data);
-            bstmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_NPCBOT_SPEC);
-            //"UPDATE characters_npcbot SET spec = ? WHERE entry = ?", CONNECTION_ASYNCH
-            bstmt->setUInt8(0, itr->second->spec);
-            bstmt->setUInt32(1, entry);
-            CharacterDatabase.Execute(bstmt);
+            MarkNpcBotDataDirty(entry);
             break;
         case NPCBOT_UPDATE_FACTION:
             itr->second->faction = *(uint32*)(data);
-            bstmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_NPCBOT_FACTION);
-            //"UPDATE characters_npcbot SET faction = ? WHERE entry = ?", CONNECTION_ASYNCH
-            bstmt->setUInt32(0, itr->second->faction);
-            bstmt->setUInt32(1, entry);
-            CharacterDatabase.Execute(bstmt);
+            MarkNpcBotDataDirty(entry);
             break;
         case NPCBOT_UPDATE_DISABLED_SPELLS:
         {
             NpcBotData::DisabledSpellsContainer const* spells = (NpcBotData::DisabledSpellsContainer const*)(data);
-            std::ostringstream ss;
-            for (NpcBotData::DisabledSpellsContainer::const_iterator citr = spells->begin(); citr != spells->end(); ++citr)
-                ss << (*citr) << ' ';
-
-            bstmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_NPCBOT_DISABLED_SPELLS);
-            //"UPDATE characters_npcbot SET spells_disabled = ? WHERE entry = ?", CONNECTION_ASYNCH
-            bstmt->setString(0, ss.str());
-            bstmt->setUInt32(1, entry);
-            CharacterDatabase.Execute(bstmt);
+            if (spells != &itr->second->disabled_spells)
+                itr->second->disabled_spells = *spells;
+            MarkNpcBotDataDirty(entry);
             break;
         }
         case NPCBOT_UPDATE_MISCVALUES:
         {
             NpcBotData::MiscValuesContainer const* miscvals = (NpcBotData::MiscValuesContainer const*)(data);
-            std::ostringstream ss;
-            for (NpcBotData::MiscValuesContainer::const_iterator citr = miscvals->cbegin(); citr != miscvals->cend(); ++citr)
-                ss << citr->first << ':' << citr->second << ' ';
-
-            bstmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_NPCBOT_MISCVALUES);
-            //"UPDATE characters_npcbot SET miscvalues = ? WHERE entry = ?", CONNECTION_ASYNCH
-            bstmt->setString(0, ss.str());
-            bstmt->setUInt32(1, entry);
-            CharacterDatabase.Execute(bstmt);
+            if (miscvals != &itr->second->miscvalues)
+                itr->second->miscvalues = *miscvals;
+            MarkNpcBotDataDirty(entry);
             break;
         }
         case NPCBOT_UPDATE_EQUIPS:
@@ -2813,6 +3037,10 @@ void BotDataMgr::UpdateNpcBotData(uint32 entry, NpcBotDataUpdateType updateType,
         {
             NpcBotDataMap::iterator bitr = _botsData.find(entry);
             ASSERT(bitr != _botsData.end());
+            {
+                std::lock_guard<std::mutex> lock(_botsDataDirtyLock);
+                _botsDataDirty.erase(entry);
+            }
             delete bitr->second;
             _botsData.erase(bitr);
             bstmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_NPCBOT);
@@ -2973,6 +3201,8 @@ void BotDataMgr::ResetNpcBotTransmogData(uint32 entry, bool update_db)
 
 void BotDataMgr::RegisterBot(Creature const* bot)
 {
+    std::unique_lock<std::shared_mutex> lock(*GetLock());
+
     if (_existingBots.find(bot) != _existingBots.end())
     {
         BOT_LOG_ERROR("entities.unit", "BotDataMgr::RegisterBot: bot {} ({}) already registered!",
@@ -2980,13 +3210,23 @@ void BotDataMgr::RegisterBot(Creature const* bot)
         return;
     }
 
-    std::unique_lock<std::shared_mutex> lock(*GetLock());
-
     _existingBots.insert(bot);
+    auto [eitr, inserted] = _existingBotsByEntry.try_emplace(bot->GetEntry(), bot);
+    if (!inserted)
+    {
+        ++_existingBotsDuplicateEntries;
+        BOT_LOG_ERROR("entities.unit", "BotDataMgr::RegisterBot: bot {} ({}) registered while another bot with the same entry exists, lookups by entry keep returning the first one!",
+            bot->GetEntry(), bot->GetName());
+    }
+    NpcBotDataMap::const_iterator ditr = _botsData.find(bot->GetEntry());
+    IndexBotOwner(bot, ditr != _botsData.cend() ? ditr->second->owner : 0);
+    IndexBotNames(bot);
     //BOT_LOG_ERROR("entities.unit", "BotDataMgr::RegisterBot: registered bot {} ({})", bot->GetEntry(), bot->GetName());
 }
 void BotDataMgr::UnregisterBot(Creature const* bot)
 {
+    std::unique_lock<std::shared_mutex> lock(*GetLock());
+
     if (_existingBots.find(bot) == _existingBots.end())
     {
         BOT_LOG_ERROR("entities.unit", "BotDataMgr::UnregisterBot: bot {} ({}) not found!",
@@ -2994,48 +3234,54 @@ void BotDataMgr::UnregisterBot(Creature const* bot)
         return;
     }
 
-    std::unique_lock<std::shared_mutex> lock(*GetLock());
-
     _existingBots.erase(bot);
+    NpcBotEntryIndex::iterator eitr = _existingBotsByEntry.find(bot->GetEntry());
+    if (eitr != _existingBotsByEntry.end() && eitr->second != bot)
+        --_existingBotsDuplicateEntries;
+    else if (eitr != _existingBotsByEntry.end())
+    {
+        //a duplicate registered later takes over the entry
+        NpcBotRegistry::const_iterator dci = _existingBots.cend();
+        if (_existingBotsDuplicateEntries)
+            dci = std::find_if(_existingBots.cbegin(), _existingBots.cend(),
+                [entry = bot->GetEntry()](Creature const* existing) { return existing->GetEntry() == entry; });
+
+        if (dci != _existingBots.cend())
+        {
+            eitr->second = *dci;
+            --_existingBotsDuplicateEntries;
+        }
+        else
+            _existingBotsByEntry.erase(eitr);
+    }
+    UnindexBotOwner(bot);
+    UnindexBotNames(bot);
+    _existingBotsKeys.erase(bot);
     //BOT_LOG_ERROR("entities.unit", "BotDataMgr::UnregisterBot: unregistered bot {} ({})", bot->GetEntry(), bot->GetName());
 }
 Creature const* BotDataMgr::FindBot(uint32 entry)
 {
     std::shared_lock<std::shared_mutex> lock(*GetLock());
 
-    for (NpcBotRegistry::const_iterator ci = _existingBots.cbegin(); ci != _existingBots.cend(); ++ci)
-    {
-        if ((*ci)->GetEntry() == entry)
-            return *ci;
-    }
-    return nullptr;
+    NpcBotEntryIndex::const_iterator ci = _existingBotsByEntry.find(entry);
+    return ci != _existingBotsByEntry.cend() ? ci->second : nullptr;
 }
 Creature const* BotDataMgr::FindBot(std::string_view name, LocaleConstant loc, std::vector<uint32> const* not_ids)
 {
     std::wstring wname;
-    if (Utf8toWStr(name, wname))
+    if (NormalizeBotName(name, wname))
     {
-        wstrToLower(wname);
+        if (loc >= TOTAL_LOCALES)
+            loc = LOCALE_enUS;
+
         std::shared_lock<std::shared_mutex> lock(*GetLock());
-        for (NpcBotRegistry::const_iterator ci = _existingBots.cbegin(); ci != _existingBots.cend(); ++ci)
+        auto [first, last] = _existingBotsByName[loc].equal_range(wname);
+        for (NpcBotNameIndex::const_iterator ci = first; ci != last; ++ci)
         {
-            if (not_ids && std::find(not_ids->cbegin(), not_ids->cend(), (*ci)->GetEntry()) != not_ids->cend())
+            if (not_ids && std::find(not_ids->cbegin(), not_ids->cend(), ci->second->GetEntry()) != not_ids->cend())
                 continue;
 
-            std::string basename = (*ci)->GetName();
-            if (CreatureLocale const* creatureInfo = sObjectMgr->GetCreatureLocale((*ci)->GetEntry()))
-            {
-                if (creatureInfo->Name.size() > loc && !creatureInfo->Name[loc].empty())
-                    basename = creatureInfo->Name[loc];
-            }
-
-            std::wstring wbname;
-            if (!Utf8toWStr(basename, wbname))
-                continue;
-
-            wstrToLower(wbname);
-            if (wbname == wname)
-                return *ci;
+            return ci->second;
         }
     }
 
@@ -3053,11 +3299,13 @@ void BotDataMgr::GetNPCBotGuidsByOwner(std::vector<ObjectGuid> &guids_vec, Objec
 
     std::shared_lock<std::shared_mutex> lock(*GetLock());
 
-    for (NpcBotRegistry::const_iterator ci = _existingBots.cbegin(); ci != _existingBots.cend(); ++ci)
-    {
-        if (_botsData[(*ci)->GetEntry()]->owner == owner_guid.GetCounter())
-            guids_vec.push_back((*ci)->GetGUID());
-    }
+    NpcBotOwnerIndex::const_iterator oci = _existingBotsByOwner.find(owner_guid.GetCounter());
+    if (oci == _existingBotsByOwner.cend())
+        return;
+
+    guids_vec.reserve(guids_vec.size() + oci->second.size());
+    for (Creature const* bot : oci->second)
+        guids_vec.push_back(bot->GetGUID());
 }
 
 ObjectGuid BotDataMgr::GetNPCBotGuid(uint32 entry)
@@ -3066,13 +3314,8 @@ ObjectGuid BotDataMgr::GetNPCBotGuid(uint32 entry)
 
     std::shared_lock<std::shared_mutex> lock(*GetLock());
 
-    for (NpcBotRegistry::const_iterator ci = _existingBots.cbegin(); ci != _existingBots.cend(); ++ci)
-    {
-        if ((*ci)->GetEntry() == entry)
-            return (*ci)->GetGUID();
-    }
-
-    return ObjectGuid::Empty;
+    NpcBotEntryIndex::const_iterator ci = _existingBotsByEntry.find(entry);
+    return ci != _existingBotsByEntry.cend() ? ci->second->GetGUID() : ObjectGuid::Empty;
 }
 
 std::vector<uint32> BotDataMgr::GetExistingNPCBotIds()
@@ -3451,6 +3694,10 @@ public:
 
     void OnShutdown() override
     {
+        SaveDirtyNpcBotData();
+        BotLogger::Flush();
+        if (_botsWanderSpawnPool)
+            _botsWanderSpawnPool->Join();
         botSpawnEvents.KillAllEvents(true);
         for (auto& kv : botBGJoinEvents)
             kv.second.KillAllEvents(true);
@@ -204,6 +204,14 @@ typedef std::array<ItemIdVector, LEVEL_STEPS> ItemLeveledArr;
 typedef std::array<ItemLeveledArr, BOT_INVENTORY_SIZE> ItemPerSlot;
 typedef std::array<ItemPerSlot, BOT_CLASS_END> ItemPerBotClassMap;
 
+//prepared in background for a queued wandering bot, consumed by its first spawn
+struct WanderingBotSpawnPrep
+{
+    uint8 baseLevel;
+    uint8 gearLevel;
+    std::array<ItemIdVector, BOT_INVENTORY_SIZE> gear; //items passing class and level requirements
+};
+
 class BotDataMgr
 {
     public:
@@ -250,10 +258,12 @@ class BotDataMgr
         static bool GenerateBattlegroundBots(Player const* groupLeader, Group const* group, BattlegroundQueue* queue, PvPDifficultyEntry const* bracketEntry, GroupQueueInfo const* gqinfo);
         static void CreateWanderingBotsSortedGear();
         static ItemPerBotClassMap const& GetWanderingBotsSortedGearMap();
-        static Item* GenerateWanderingBotItem(uint8 slot, uint8 botclass, uint8 level, std::function<bool(ItemTemplate const*)>&& check);
+        static Item* GenerateWanderingBotItem(uint8 slot, uint8 botclass, uint8 level, std::function<bool(ItemTemplate const*)>&& check, ItemIdVector const* candidates = nullptr);
         static bool GenerateWanderingBotItemEnchants(Item* item, uint8 slot, uint8 spec);
         static CreatureTemplate const* GetBotExtraCreatureTemplate(uint32 entry);
         static EquipmentInfo const* GetBotEquipmentInfo(uint32 entry);
+        static WanderingBotSpawnPrep const* GetWanderingBotSpawnPrep(uint32 entry);
+        static void ReleaseWanderingBotSpawnPrep(uint32 entry);
 
         static uint8 GetLevelBonusForBotRank(uint32 rank);
         static uint8 GetMinLevelForMapId(uint32 mapId);
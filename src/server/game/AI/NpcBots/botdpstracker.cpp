@@ -8,17 +8,9 @@ Comment: dps taken tracker for NPCBot system by Trickerer (onlysuffering@gmail.c
 DPS trackers may collect data from different bot owners if in party but this overdoing has no significance whatsoever
 */
 
-enum DPSTrackerConstants : uint32
-{
-    DPS_UPDATE_TIMER        =  500, //recalculate dps every x ms
-    MAX_DPS_TRACK_TIME      = 5000, //track damage taken for last x ms
-    DPS_INACTIVE_TIMER      = 5000, //reset if combat not active for botparty for x ms
-    //maximum tracked damage taken periods of DPS_UPDATE_TIMER during MAX_DPS_TRACK_TIME
-    MAX_DAMAGES             = MAX_DPS_TRACK_TIME/DPS_UPDATE_TIMER
-};
-
 DPSTracker::DPSTracker()
 {
+    _head = 0;
     _updateTimer = 0;
     _inactiveTimer = 0;
     _trackTimer = 0;
@@ -27,11 +19,6 @@ DPSTracker::DPSTracker()
 
 DPSTracker::~DPSTracker()
 {
-    for (DamageTakenMap::const_iterator itr = _damages.begin(); itr != _damages.end(); ++itr)
-        delete[] itr->second;
-
-    _damages.clear();
-    _DPSes.clear();
 }
 
 void DPSTracker::Update(uint32 diff)
@@ -60,11 +47,9 @@ void DPSTracker::_Reset()
     {
         _active = false;
 
-        for (DamageTakenMap::const_iterator itr = _damages.begin(); itr != _damages.end(); ++itr)
-            for (uint8 i = 0; i != MAX_DAMAGES; ++i)
-                itr->second[i] = 0;
-        for (DPSTakenMap::iterator itr = _DPSes.begin(); itr != _DPSes.end(); ++itr)
-            itr->second = 0;
+        _guids.clear();
+        _units.clear();
+        _head = 0;
 
         _updateTimer = 0;
         _inactiveTimer = 0;
@@ -74,40 +59,46 @@ void DPSTracker::_Reset()
 
 void DPSTracker::_Release()
 {
-    for (DamageTakenMap::const_iterator itr = _damages.begin(); itr != _damages.end(); ++itr)
+    float const seconds = 0.001f * std::max<uint32>(1 * IN_MILLISECONDS, std::min<uint32>(_trackTimer, MAX_DPS_TRACK_TIME));
+    uint32 const next = (_head + 1) % MAX_DAMAGES;
+
+    for (TrackedUnit& unit : _units)
     {
-        uint32* dmgs = itr->second;
-        uint32 total_damage = 0;
-        for (uint8 i = 0; i != MAX_DAMAGES; ++i)
-            total_damage += dmgs[i];
-
-        _DPSes[itr->first] = uint32(total_damage / (0.001f * std::max<uint32>(1 * IN_MILLISECONDS, std::min<uint32>(_trackTimer, MAX_DPS_TRACK_TIME))));
-        //BOT_LOG_ERROR("entities.player", "DPSTracker::Release(): guidlow = {}, time = {}, tick damage {}, total {}, dps = {}",
-        //    itr->first, _trackTimer, dmgs[0], total_damage, _DPSes[itr->first]);
-
-        //shift
-        for (int8 i = MAX_DAMAGES-1; i > 0; --i)
-            dmgs[i] = dmgs[i-1];
-        dmgs[0] = 0;
+        unit.dps = uint32(unit.total / seconds);
+        //BOT_LOG_ERROR("entities.player", "DPSTracker::Release(): time = {}, tick damage {}, total {}, dps = {}",
+        //    _trackTimer, unit.damages[_head], unit.total, unit.dps);
+
+        //drop oldest period
+        unit.total -= unit.damages[next];
+        unit.damages[next] = 0;
     }
+
+    _head = next;
 }
 
-void DPSTracker::_AccumulateDamage(uint64 guid, uint32 damage)
+int32 DPSTracker::_FindUnit(uint64 guid) const
 {
-    DamageTakenMap::const_iterator itr = _damages.find(guid);
+    for (size_t i = 0; i != _guids.size(); ++i)
+        if (_guids[i] == guid)
+            return int32(i);
 
-    if (itr == _damages.end())
-    {
-        uint32* dmgarray = new uint32[MAX_DAMAGES];
-        memset(dmgarray, 0, sizeof(uint32)*MAX_DAMAGES);
+    return -1;
+}
 
-        dmgarray[0] = damage;
+void DPSTracker::_AccumulateDamage(uint64 guid, uint32 damage)
+{
+    int32 index = _FindUnit(guid);
 
-        _damages[guid] = dmgarray;
-        return;
+    if (index < 0)
+    {
+        index = int32(_units.size());
+        _guids.push_back(guid);
+        _units.push_back({});
     }
 
-    itr->second[0] += damage;
+    TrackedUnit& unit = _units[index];
+    unit.damages[_head] += damage;
+    unit.total += damage;
 }
 //victim is bot owner, bot, party player or party bot; checked in Unit::DealDamage()
 void DPSTracker::TrackDamage(Unit const* victim, uint32 damage)
@@ -127,7 +118,7 @@ void DPSTracker::_SetActive()
 
 uint32 DPSTracker::GetDPSTaken(uint64 guid) const
 {
-    DPSTakenMap::const_iterator itr = _DPSes.find(guid);
-    //BOT_LOG_ERROR("entities.player", "DPSTracker::GetDPSTaken(): from {}, damage {}", guid, itr != _DPSes.end() ? itr->second : 0);
-    return itr != _DPSes.end() ? itr->second : 0;
+    int32 index = _FindUnit(guid);
+    //BOT_LOG_ERROR("entities.player", "DPSTracker::GetDPSTaken(): from {}, damage {}", guid, index >= 0 ? _units[index].dps : 0);
+    return index >= 0 ? _units[index].dps : 0;
 }
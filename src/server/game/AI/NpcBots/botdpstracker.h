@@ -3,10 +3,20 @@
 
 #include "Define.h"
 
-#include <unordered_map>
+#include <array>
+#include <vector>
 
 class Unit;
 
+enum DPSTrackerConstants : uint32
+{
+    DPS_UPDATE_TIMER        =  500, //recalculate dps every x ms
+    MAX_DPS_TRACK_TIME      = 5000, //track damage taken for last x ms
+    DPS_INACTIVE_TIMER      = 5000, //reset if combat not active for botparty for x ms
+    //maximum tracked damage taken periods of DPS_UPDATE_TIMER during MAX_DPS_TRACK_TIME
+    MAX_DAMAGES             = MAX_DPS_TRACK_TIME/DPS_UPDATE_TIMER
+};
+
 class DPSTracker
 {
     public:
@@ -23,11 +33,20 @@ class DPSTracker
         void _Release();
         void _AccumulateDamage(uint64 guid, uint32 damage);
         void _SetActive();
-
-        typedef std::unordered_map<uint64 /*guid*/, uint32* /*dmgarray*/> DamageTakenMap;
-        typedef std::unordered_map<uint64 /*guid*/, uint32 /*dps*/> DPSTakenMap;
-        DamageTakenMap _damages;
-        DPSTakenMap _DPSes;
+        int32 _FindUnit(uint64 guid) const;
+
+        //damage of last MAX_DAMAGES periods, all units share ring position
+        struct TrackedUnit
+        {
+            std::array<uint32, MAX_DAMAGES> damages;
+            uint32 total;
+            uint32 dps;
+        };
+
+        //parallel arrays, guids are scanned linearly (party members only); storage is kept between combats
+        std::vector<uint64> _guids;
+        std::vector<TrackedUnit> _units;
+        uint32 _head;
 
         uint32 _updateTimer;
         uint32 _inactiveTimer;
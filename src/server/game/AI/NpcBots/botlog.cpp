@@ -6,6 +6,93 @@
 #include "DatabaseEnvFwd.h"
 #include "Log.h"
 
+#include <array>
+#include <mutex>
+#include <vector>
+
+//rows are buffered and written in one transaction by BotLogger::Flush()
+constexpr std::size_t BOT_LOG_FLUSH_ROWS = 256; // logging thread flushes once this many rows are pending
+
+struct BotLogRow
+{
+    uint32 entry;
+    int32 owner;
+    int32 mapid;
+    int8 inmap;
+    int8 inworld;
+    uint16 type;
+    std::array<std::string, MAX_BOT_LOG_PARAMS> params;
+};
+
+static std::vector<BotLogRow> _pendingLogRows;
+static std::mutex _pendingLogRowsLock;
+static uint64 _flushedLogRows = 0;
+static uint32 _forcedLogFlushes = 0;
+
+static void SetBotLogRow(CharacterDatabasePreparedStatement* bstmt, uint32 index, BotLogRow const& row)
+{
+    //(entry, owner, mapid, inmap, inworld, type, param1, param2, param3, param4, param5)
+    bstmt->setUInt32(  index, row.entry);
+    bstmt->setInt32 (++index, row.owner);
+    bstmt->setInt32 (++index, row.mapid);
+    bstmt->setInt8  (++index, row.inmap);
+    bstmt->setInt8  (++index, row.inworld);
+    bstmt->setUInt16(++index, row.type);
+    for (std::string const& param : row.params)
+        bstmt->setString(++index, param);
+}
+
+static void WriteBotLogRows(std::vector<BotLogRow> const& rows)
+{
+    constexpr uint32 BOT_LOG_ROW_PARAMS = 6 + MAX_BOT_LOG_PARAMS;
+
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+
+    //full groups go as one multi-row insert, the remainder row by row
+    std::size_t const batched = rows.size() - rows.size() % NPCBOT_LOG_BATCH_ROWS;
+    for (std::size_t i = 0; i < batched; i += NPCBOT_LOG_BATCH_ROWS)
+    {
+        CharacterDatabasePreparedStatement* bstmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_NPCBOT_LOG_BATCH);
+        for (uint32 j = 0; j < NPCBOT_LOG_BATCH_ROWS; ++j)
+            SetBotLogRow(bstmt, j * BOT_LOG_ROW_PARAMS, rows[i + j]);
+        trans->Append(bstmt);
+    }
+    for (std::size_t i = batched; i < rows.size(); ++i)
+    {
+        CharacterDatabasePreparedStatement* bstmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_NPCBOT_LOG);
+        SetBotLogRow(bstmt, 0, rows[i]);
+        trans->Append(bstmt);
+    }
+
+    CharacterDatabase.CommitTransaction(trans);
+}
+
+void BotLogger::Flush(bool forced)
+{
+    std::vector<BotLogRow> rows;
+    uint64 flushedRows;
+    uint32 forcedFlushes;
+    {
+        std::lock_guard<std::mutex> lock(_pendingLogRowsLock);
+        if (_pendingLogRows.empty())
+            return;
+
+        rows.swap(_pendingLogRows);
+        _pendingLogRows.reserve(BOT_LOG_FLUSH_ROWS);
+        _flushedLogRows += rows.size();
+        if (forced)
+            ++_forcedLogFlushes;
+
+        flushedRows = _flushedLogRows;
+        forcedFlushes = _forcedLogFlushes;
+    }
+
+    BOT_LOG_DEBUG("npcbots", "Bot logger: writing {} rows ({} total, {} flushes forced by full buffer)",
+        uint32(rows.size()), flushedRows, forcedFlushes);
+
+    WriteBotLogRows(rows);
+}
+
 template<typename... Args>
 static void BotLogImpl(uint16 log_type, uint32 entry, int32 owner, int32 mapid, int8 inmap, int8 inworld, Args&&... params)
 {
@@ -24,18 +111,19 @@ static void BotLogImpl(uint16 log_type, uint32 entry, int32 owner, int32 mapid,
         }
     }
 
-    CharacterDatabasePreparedStatement* bstmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_NPCBOT_LOG);
-    //"INSERT INTO characters_npcbot_logs (entry, owner, mapid, inmap, inworld, type, param1, param2, param3, param4, param5) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)", CONNECTION_ASYNC
-    uint32 index = 0;
-    bstmt->setUInt32(  index, entry);
-    bstmt->setInt32 (++index, owner);
-    bstmt->setInt32 (++index, mapid);
-    bstmt->setInt8  (++index, inmap);
-    bstmt->setInt8  (++index, inworld);
-    bstmt->setUInt16(++index, log_type);
-    for (std::string const& param : sparams)
-        bstmt->setString(++index, param);
-    CharacterDatabase.Execute(bstmt);
+    BotLogRow row{ .entry = entry, .owner = owner, .mapid = mapid, .inmap = inmap, .inworld = inworld, .type = log_type, .params = {} };
+    std::move(sparams.begin(), sparams.end(), row.params.begin());
+
+    bool full;
+    {
+        std::lock_guard<std::mutex> lock(_pendingLogRowsLock);
+        _pendingLogRows.push_back(std::move(row));
+        full = _pendingLogRows.size() >= BOT_LOG_FLUSH_ROWS;
+    }
+
+    //backpressure: the thread filling up the buffer pays for writing it
+    if (full)
+        BotLogger::Flush(true);
 }
 
 template<typename... Args>
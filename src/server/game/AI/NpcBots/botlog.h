@@ -34,6 +34,9 @@ class BotLogger
         template<typename... Args>
         requires NPCBots::LoggableArguments<Args...>
         static void Log(uint16 log_type, uint32 entry, Args&&... params);
+
+        //write buffered rows, called periodically by BotDataMgr and on shutdown
+        static void Flush(bool forced = false);
 };
 
 #endif //BOTLOG_H_
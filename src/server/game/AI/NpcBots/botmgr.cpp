@@ -12,6 +12,7 @@
 #include "Chat.h"
 #include "CombatPackets.h"
 #include "Config.h"
+#include "GameTime.h"
 #include "GroupMgr.h"
 #include "GridNotifiers.h"
 #include "GridNotifiersImpl.h"
@@ -74,6 +75,9 @@ uint32 _npcBotEngageDelayDPS_default;
 uint32 _npcBotEngageDelayHeal_default;
 uint32 _npcBotOwnerExpireTime;
 uint32 _desiredWanderingBotsCount;
+uint32 _unobservedWandererUpdateDelay;
+uint32 _wanderingBotsSpawnThreads;
+uint32 _wanderingBotsSpawnPerUpdate;
 uint32 _killrewardWandererMoneyBase;
 uint32 _killrewardWandererItemCount;
 uint32 _killrewardWandererItemQuality;
@@ -284,6 +288,8 @@ BotMgr::BotMgr(Player* const master) : _owner(master), _dpstracker(new DPSTracke
     _quickrecall = false;
     _update_lock = false;
     _data = nullptr;
+    _nearbyUnitsMap = nullptr;
+    _nearbyUnitsTime = 0;
 }
 BotMgr::~BotMgr()
 {
@@ -454,6 +460,9 @@ void BotMgr::LoadConfig(bool reload)
     _botStatLimits_block            = sConfigMgr->GetFloatDefault("NpcBot.Stats.Limits.Block", 95.0f);
     _botStatLimits_crit             = sConfigMgr->GetFloatDefault("NpcBot.Stats.Limits.Crit", 95.0f);
     _desiredWanderingBotsCount      = sConfigMgr->GetIntDefault("NpcBot.WanderingBots.Continents.Count", 0);
+    _unobservedWandererUpdateDelay  = sConfigMgr->GetIntDefault("NpcBot.WanderingBots.Unobserved.UpdateDelay", 0);
+    _wanderingBotsSpawnThreads      = sConfigMgr->GetIntDefault("NpcBot.WanderingBots.Spawn.Threads", 1);
+    _wanderingBotsSpawnPerUpdate    = sConfigMgr->GetIntDefault("NpcBot.WanderingBots.Spawn.PerUpdate", 4);
     _killrewardWandererMoneyBase    = sConfigMgr->GetIntDefault("NpcBot.WanderingBots.KillReward.Money", 0);
     _killrewardWandererItemCount    = sConfigMgr->GetIntDefault("NpcBot.WanderingBots.KillReward.ItemCount", 0);
     _killrewardWandererItemQuality  = sConfigMgr->GetIntDefault("NpcBot.WanderingBots.KillReward.ItemQuality", int(ITEM_QUALITY_RARE));
@@ -667,6 +676,7 @@ void BotMgr::LoadConfig(bool reload)
     RoundToInterval(_bothk_rate_honor, 0.1f, 10.f);
     RoundToInterval(_killrewardWandererItemCount, uint32(0), uint32(MAX_NR_LOOT_ITEMS));
     RoundToInterval(_killrewardWandererItemQuality, uint32(ITEM_QUALITY_POOR), uint32(ITEM_QUALITY_HEIRLOOM));
+    _wanderingBotsSpawnPerUpdate = std::max<uint32>(_wanderingBotsSpawnPerUpdate, 1u);
 }
 
 void BotMgr::ResolveConfigConflicts()
@@ -1066,6 +1076,18 @@ uint32 BotMgr::GetDesiredWanderingBotsCount()
 {
     return _desiredWanderingBotsCount;
 }
+uint32 BotMgr::GetUnobservedWandererUpdateDelay()
+{
+    return _unobservedWandererUpdateDelay;
+}
+uint32 BotMgr::GetWanderingBotsSpawnThreads()
+{
+    return _wanderingBotsSpawnThreads;
+}
+uint32 BotMgr::GetWanderingBotsSpawnPerUpdate()
+{
+    return _wanderingBotsSpawnPerUpdate;
+}
 uint32 BotMgr::GetBGTargetTeamPlayersCount(BattlegroundTypeId bgTypeId)
 {
     switch (bgTypeId)
@@ -2863,6 +2885,37 @@ void BotMgr::PropagateEngageTimers() const
     }
 }
 
+std::vector<Unit*> const* BotMgr::GetNearbyUnits(Unit const* bot, WorldObject const* center, float dist)
+{
+    static constexpr float NEARBY_UNITS_RADIUS = 70.f;
+
+    if (!_owner->IsInWorld() || bot->GetMap() != _owner->GetMap() || bot->GetPhaseMask() != _owner->GetPhaseMask() ||
+        _owner->GetExactDist2d(center) + dist + center->GetCombatReach() > NEARBY_UNITS_RADIUS)
+        return nullptr;
+
+    //objects are only removed from map after all units are updated, pointers are valid for the rest of the tick
+    uint32 now = GameTime::GetGameTimeMS();
+    if (_nearbyUnitsMap != _owner->GetMap() || _nearbyUnitsTime != now)
+    {
+        _nearbyUnitsMap = _owner->GetMap();
+        _nearbyUnitsTime = now;
+        _nearbyUnits.clear();
+
+        //prefilter by packed cell indexes, then exact distance check (same as Cell::VisitAllObjects(_owner, ...) radius)
+        std::vector<WorldObject*> candidates;
+        Cell::SearchObjects(_owner->GetPositionX(), _owner->GetPositionY(), _owner->GetMap(), NEARBY_UNITS_RADIUS + _owner->GetCombatReach(),
+            GRID_MAP_TYPE_MASK_CREATURE | GRID_MAP_TYPE_MASK_PLAYER, _owner->GetPhaseMask(), candidates);
+        for (WorldObject* obj : candidates)
+        {
+            Unit* u = obj->ToUnit();
+            if (u && _owner->IsWithinDist(u, NEARBY_UNITS_RADIUS, false))
+                _nearbyUnits.push_back(u);
+        }
+    }
+
+    return &_nearbyUnits;
+}
+
 void BotMgr::TrackDamage(Unit const* u, uint32 damage)
 {
     _dpstracker->TrackDamage(u, damage);
@@ -2870,7 +2923,12 @@ void BotMgr::TrackDamage(Unit const* u, uint32 damage)
 
 uint32 BotMgr::GetDPSTaken(Unit const* u) const
 {
-    return _dpstracker->GetDPSTaken(u->GetGUID().GetRawValue());
+    //damage is tracked by victim's owner (see Unit::DealDamage()), read it there so every bot in party gets the same value
+    Player const* owner = u->GetTypeId() == TYPEID_PLAYER ? u->ToPlayer() :
+        u->IsNPCBot() && !u->ToCreature()->IsFreeBot() ? u->ToCreature()->GetBotOwner() : nullptr;
+    BotMgr const* mgr = (owner && owner->GetBotMgr() && owner->FindMap() == _owner->GetMap()) ? owner->GetBotMgr() : this;
+
+    return mgr->_dpstracker->GetDPSTaken(u->GetGUID().GetRawValue());
 }
 
 int32 BotMgr::GetHPSTaken(Unit const* unit) const
@@ -2878,56 +2936,13 @@ int32 BotMgr::GetHPSTaken(Unit const* unit) const
     if (!HaveBot())
         return 0;
 
-    std::list<Unit*> unitList;
     Group const* gr = _owner->GetGroup();
-    if (!gr)
-    {
-        if (_owner->HasUnitState(UNIT_STATE_CASTING))
-            unitList.push_back(_owner);
-        for (BotMap::const_iterator itr = _bots.begin(); itr != _bots.end(); ++itr)
-            if (itr->second->GetTarget() == unit->GetGUID() && itr->second->HasUnitState(UNIT_STATE_CASTING))
-                unitList.push_back(itr->second);
-    }
-    else
-    {
-        bool Bots = false;
-        for (GroupReference const* itr = gr->GetFirstMember(); itr != nullptr; itr = itr->next())
-        {
-            Player* player = itr->GetSource();
-            if (player == nullptr) continue;
-            if (_owner->GetMap() != player->FindMap()) continue;
-            if (!Bots)
-                Bots = true;
-            if (player->HasUnitState(UNIT_STATE_CASTING))
-                unitList.push_back(player);
-        }
-        if (Bots)
-        {
-            for (GroupReference const* gitr = gr->GetFirstMember(); gitr != nullptr; gitr = gitr->next())
-            {
-                if (gitr->GetSource() == nullptr) continue;
-                if (_owner->GetMap() != gitr->GetSource()->FindMap()) continue;
-
-                if (gitr->GetSource()->HaveBot())
-                {
-                    BotMap const* map = gitr->GetSource()->GetBotMgr()->GetBotMap();
-                    for (BotMap::const_iterator itr = map->begin(); itr != map->end(); ++itr)
-                        if (itr->second->GetTarget() == unit->GetGUID() && itr->second->HasUnitState(UNIT_STATE_CASTING))
-                            unitList.push_back(itr->second);
-                }
-            }
-        }
-    }
-
     int32 amount = 0;
 
-    Unit* u;
-    Spell const* spell;
-    SpellInfo const* spellInfo;
-    for (std::list<Unit*>::const_iterator itr = unitList.begin(); itr != unitList.end(); ++itr)
-    {
-        u = *itr;
-
+    //pending heals of casters, applied directly instead of collecting casters first
+    auto add_pending_heals = [this, unit, gr, &amount](Unit* u) {
+        Spell const* spell;
+        SpellInfo const* spellInfo;
         for (uint8 i = CURRENT_FIRST_NON_MELEE_SPELL; i != CURRENT_AUTOREPEAT_SPELL; ++i)
         {
             spell = u->GetCurrentSpell(CurrentSpellTypes(i));
@@ -2981,6 +2996,45 @@ int32 BotMgr::GetHPSTaken(Unit const* unit) const
 
             break;
         }
+    };
+
+    if (!gr)
+    {
+        if (_owner->HasUnitState(UNIT_STATE_CASTING))
+            add_pending_heals(_owner);
+        for (BotMap::const_iterator itr = _bots.begin(); itr != _bots.end(); ++itr)
+            if (itr->second->GetTarget() == unit->GetGUID() && itr->second->HasUnitState(UNIT_STATE_CASTING))
+                add_pending_heals(itr->second);
+    }
+    else
+    {
+        bool Bots = false;
+        for (GroupReference const* itr = gr->GetFirstMember(); itr != nullptr; itr = itr->next())
+        {
+            Player* player = itr->GetSource();
+            if (player == nullptr) continue;
+            if (_owner->GetMap() != player->FindMap()) continue;
+            if (!Bots)
+                Bots = true;
+            if (player->HasUnitState(UNIT_STATE_CASTING))
+                add_pending_heals(player);
+        }
+        if (Bots)
+        {
+            for (GroupReference const* gitr = gr->GetFirstMember(); gitr != nullptr; gitr = gitr->next())
+            {
+                if (gitr->GetSource() == nullptr) continue;
+                if (_owner->GetMap() != gitr->GetSource()->FindMap()) continue;
+
+                if (gitr->GetSource()->HaveBot())
+                {
+                    BotMap const* map = gitr->GetSource()->GetBotMgr()->GetBotMap();
+                    for (BotMap::const_iterator itr = map->begin(); itr != map->end(); ++itr)
+                        if (itr->second->GetTarget() == unit->GetGUID() && itr->second->HasUnitState(UNIT_STATE_CASTING))
+                            add_pending_heals(itr->second);
+                }
+            }
+        }
     }
 
     //HoTs
@@ -161,6 +161,9 @@ class TC_GAME_API BotMgr
         static uint32 GetOwnershipExpireTime();
         static uint8 GetOwnershipExpireMode();
         static uint32 GetDesiredWanderingBotsCount();
+        static uint32 GetUnobservedWandererUpdateDelay();
+        static uint32 GetWanderingBotsSpawnThreads();
+        static uint32 GetWanderingBotsSpawnPerUpdate();
         static uint32 GetBGTargetTeamPlayersCount(BattlegroundTypeId bgTypeId);
         static float GetBotHKHonorRate();
         static float GetBotStatLimitDodge();
@@ -336,6 +339,10 @@ class TC_GAME_API BotMgr
         static void SetBotPetAuraUpdateMaskForRaid(Creature const* botpet, uint8 slot);
         static void ResetBotPetAuraUpdateMaskForRaid(Creature const* botpet);
 
+        //units around owner, gathered once per world tick and shared by all bots of this player
+        //nullptr if the query is not covered (bot on another map or phase, or too far from owner)
+        std::vector<Unit*> const* GetNearbyUnits(Unit const* bot, WorldObject const* center, float dist);
+
         void TrackDamage(Unit const* u, uint32 damage);
         uint32 GetDPSTaken(Unit const* u) const;
         int32 GetHPSTaken(Unit const* unit) const;
@@ -379,6 +386,10 @@ class TC_GAME_API BotMgr
 
         AoeSpotsVec _aoespots;
 
+        std::vector<Unit*> _nearbyUnits;
+        Map const* _nearbyUnitsMap;
+        uint32 _nearbyUnitsTime;
+
         std::array<std::string, TARGET_ICON_NAMES_CACHE_SIZE> _targetIconNamesCache;
 };
 
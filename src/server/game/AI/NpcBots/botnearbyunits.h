@@ -0,0 +1,29 @@
+#ifndef BOTNEARBYUNITS_H_
+#define BOTNEARBYUNITS_H_
+
+#include <vector>
+
+/*
+Helpers for the per-tick nearby units cache (BotMgr::GetNearbyUnits)
+*/
+namespace NPCBots
+{
+    //Calls visitor(u) for every cached unit within dist of center, stops as soon as visitor returns false
+    //Units can leave the map after the cache was built in the same tick (far teleport, despawn, RemoveFromWorld),
+    //those are skipped before anything else is done with them
+    template<class UnitType, class SearcherType, class CenterType, class Visitor>
+    void VisitCachedNearbyUnits(std::vector<UnitType*> const& units, SearcherType const* searcher, CenterType const* center, float dist, Visitor&& visitor)
+    {
+        for (UnitType* u : units)
+        {
+            if (!u->IsInWorld() || u->GetMap() != searcher->GetMap())
+                continue;
+            if (!center->IsWithinDist(u, dist, false))
+                continue;
+            if (!visitor(u))
+                return;
+        }
+    }
+}
+
+#endif //BOTNEARBYUNITS_H_
@@ -0,0 +1,473 @@
+#include "botpathplanner.h"
+#include "DBCStructure.h"
+#include "DetourNavMesh.h"
+#include "DetourNavMeshQuery.h"
+#include "DisableMgr.h"
+#include "Map.h"
+#include "MMapFactory.h"
+#include "MMapManager.h"
+#include "PathGenerator.h"
+#include "Unit.h"
+
+#include <G3D/Vector2.h>
+#include <G3D/Vector3.h>
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+
+/*
+Name: bot_path_planner
+%Complete: 100
+Comment: hierarchical (navmesh tile portals -> navmesh legs) route planner for NPCBot wanderers
+Portal graph and portal-to-portal legs are shared by all bots on the map and survive until the tile is reloaded
+*/
+
+namespace
+{
+    //points are spaced so PathGenerator can reach next one without truncation
+    constexpr float ROUTE_POINT_SPACING = (MAX_POINT_PATH_LENGTH - 1) * SMOOTH_PATH_STEP_SIZE * 0.75f;
+    constexpr float ROUTE_POINT_MIN_SPACING = 10.0f;
+    constexpr float PORTAL_MERGE_GAP = 3.0f;
+    constexpr float PORTAL_MAX_WIDTH = 40.0f;
+    constexpr int32 MAX_LEG_POLYS = 1024;
+    constexpr int32 MAX_LEG_POINTS = 256;
+    constexpr uint32 MAX_LEG_QUERIES = 96; //navmesh searches per planned route, cached legs don't count
+    constexpr uint32 MAX_EXPANDED_NODES = 512;
+    constexpr uint32 MAX_DEAD_PORTALS = 4096;
+    constexpr uint32 NODE_START = std::numeric_limits<uint32>::max() - 1;
+    constexpr uint32 NODE_GOAL = std::numeric_limits<uint32>::max();
+    float const POLY_SEARCH_EXTENTS[VERTEX_SIZE] = { 5.0f, 10.0f, 5.0f };
+
+    //detour uses (y, z, x)
+    inline G3D::Vector3 ToWorld(float const* v) { return G3D::Vector3(v[2], v[0], v[1]); }
+    inline void ToDetour(G3D::Vector3 const& p, float* v) { v[0] = p.y; v[1] = p.z; v[2] = p.x; }
+    inline uint32 MakeTileKey(int32 x, int32 y) { return (uint32(uint16(x)) << 16) | uint32(uint16(y)); }
+    inline int32 TileKeyX(uint32 key) { return int32(uint16(key >> 16)); }
+    inline int32 TileKeyY(uint32 key) { return int32(uint16(key)); }
+    inline uint64 MakeLegKey(uint32 from, uint32 to) { return (uint64(from) << 32) | to; }
+
+    //navmesh tile border segment leading into a neighbor tile
+    struct Portal
+    {
+        uint32 tile;
+        uint32 neighbor;
+        dtPolyRef poly;
+        G3D::Vector3 pos;
+        bool dead;
+    };
+
+    struct TileInfo
+    {
+        dtTileRef ref = 0;
+        std::vector<uint32> portals;
+    };
+
+    //walkable route between two graph nodes, cost < 0 if unreachable
+    struct Leg
+    {
+        float cost = -1.0f;
+        std::vector<G3D::Vector3> points;
+    };
+
+    struct NavGraph
+    {
+        //graph is shared by all wanderers of the map, do not rely on them being updated from a single thread
+        //held for the whole PlanRoute so tiles, portals and legs never change under a running search
+        std::mutex lock;
+        dtNavMesh const* navMesh = nullptr;
+        std::unordered_map<uint32, TileInfo> tiles;
+        std::vector<Portal> portals;
+        std::unordered_map<uint64, Leg> legs;
+        uint32 deadPortals = 0;
+
+        void Reset(dtNavMesh const* mesh)
+        {
+            navMesh = mesh;
+            tiles.clear();
+            portals.clear();
+            legs.clear();
+            deadPortals = 0;
+        }
+
+        void KillPortals(TileInfo& info)
+        {
+            for (uint32 portal : info.portals)
+                portals[portal].dead = true;
+            deadPortals += uint32(info.portals.size());
+            info.portals.clear();
+        }
+
+        void BuildPortals(dtMeshTile const* tile, uint32 key, TileInfo& info)
+        {
+            struct BorderEdge
+            {
+                uint32 neighbor;
+                float lo, hi;
+                G3D::Vector3 mid;
+                dtPolyRef poly;
+            };
+
+            std::vector<BorderEdge> edges;
+            dtPolyRef const base = navMesh->getPolyRefBase(tile);
+            for (int32 i = 0; i < tile->header->polyCount; ++i)
+            {
+                dtPoly const* poly = &tile->polys[i];
+                if (poly->getType() != DT_POLYTYPE_GROUND)
+                    continue;
+
+                for (uint32 k = poly->firstLink; k != DT_NULL_LINK; k = tile->links[k].next)
+                {
+                    dtLink const& link = tile->links[k];
+                    if (link.side == 0xff)
+                        continue;
+
+                    dtMeshTile const* ntile = nullptr;
+                    dtPoly const* npoly = nullptr;
+                    if (dtStatusFailed(navMesh->getTileAndPolyByRef(link.ref, &ntile, &npoly)) || ntile == tile)
+                        continue;
+
+                    float const* va = &tile->verts[poly->verts[link.edge] * 3];
+                    float const* vb = &tile->verts[poly->verts[(link.edge + 1) % poly->vertCount] * 3];
+                    float const mid[VERTEX_SIZE] = { (va[0] + vb[0]) * 0.5f, (va[1] + vb[1]) * 0.5f, (va[2] + vb[2]) * 0.5f };
+                    //x borders (sides 0, 4) run along detour z, z borders along detour x
+                    uint8 const axis = (link.side & 2) ? 0 : 2;
+
+                    BorderEdge edge;
+                    edge.neighbor = MakeTileKey(ntile->header->x, ntile->header->y);
+                    edge.lo = std::min(va[axis], vb[axis]);
+                    edge.hi = std::max(va[axis], vb[axis]);
+                    edge.mid = ToWorld(mid);
+                    edge.poly = base | dtPolyRef(i);
+                    edges.push_back(edge);
+                }
+            }
+
+            std::sort(edges.begin(), edges.end(), [](BorderEdge const& a, BorderEdge const& b) {
+                return a.neighbor != b.neighbor ? a.neighbor < b.neighbor : a.lo < b.lo;
+            });
+
+            //merge contiguous edges into portals, splitting long borders
+            for (size_t begin = 0; begin < edges.size();)
+            {
+                size_t end = begin + 1;
+                float hi = edges[begin].hi;
+                while (end < edges.size() && edges[end].neighbor == edges[begin].neighbor &&
+                    edges[end].lo <= hi + PORTAL_MERGE_GAP && edges[end].hi - edges[begin].lo <= PORTAL_MAX_WIDTH)
+                {
+                    hi = std::max(hi, edges[end].hi);
+                    ++end;
+                }
+
+                BorderEdge const& edge = edges[begin + (end - begin) / 2];
+                info.portals.push_back(uint32(portals.size()));
+                portals.push_back({ key, edge.neighbor, edge.poly, edge.mid, false });
+                begin = end;
+            }
+        }
+
+        //tiles may be unloaded and reloaded with grids, portals are rebuilt on tile ref change
+        TileInfo const* GetTile(int32 x, int32 y)
+        {
+            uint32 const key = MakeTileKey(x, y);
+            dtMeshTile const* tile = navMesh->getTileAt(x, y, 0);
+            auto itr = tiles.find(key);
+            if (!tile || !tile->header)
+            {
+                if (itr != tiles.end())
+                {
+                    KillPortals(itr->second);
+                    tiles.erase(itr);
+                }
+                return nullptr;
+            }
+
+            dtTileRef const ref = navMesh->getTileRef(tile);
+            if (itr != tiles.end())
+            {
+                if (itr->second.ref == ref)
+                    return &itr->second;
+                KillPortals(itr->second);
+            }
+            else
+                itr = tiles.emplace(key, TileInfo()).first;
+
+            itr->second.ref = ref;
+            BuildPortals(tile, key, itr->second);
+            return &itr->second;
+        }
+
+        //closest portal on the other side of the border
+        uint32 FindPartner(uint32 portal)
+        {
+            Portal const from = portals[portal];
+            TileInfo const* ntile = GetTile(TileKeyX(from.neighbor), TileKeyY(from.neighbor));
+            if (!ntile)
+                return NODE_GOAL;
+
+            uint32 partner = NODE_GOAL;
+            float mindist = PORTAL_MAX_WIDTH;
+            for (uint32 other : ntile->portals)
+            {
+                Portal const& to = portals[other];
+                if (to.neighbor != from.tile)
+                    continue;
+                float dist = (to.pos - from.pos).length();
+                if (dist < mindist)
+                {
+                    mindist = dist;
+                    partner = other;
+                }
+            }
+            return partner;
+        }
+    };
+
+    std::unordered_map<uint32, NavGraph> _graphs;
+    std::mutex _graphsLock;
+
+    void ComputeLeg(dtNavMeshQuery const* query, dtQueryFilter const& filter, dtPolyRef fromPoly, G3D::Vector3 const& from, dtPolyRef toPoly, G3D::Vector3 const& to, Leg& leg)
+    {
+        float start[VERTEX_SIZE];
+        float end[VERTEX_SIZE];
+        ToDetour(from, start);
+        ToDetour(to, end);
+
+        dtPolyRef polys[MAX_LEG_POLYS];
+        int32 polyCount = 0;
+        dtStatus status = query->findPath(fromPoly, toPoly, start, end, &filter, polys, &polyCount, MAX_LEG_POLYS);
+        if (dtStatusFailed(status) || polyCount <= 0 || polys[polyCount - 1] != toPoly)
+            return;
+
+        float straight[MAX_LEG_POINTS * VERTEX_SIZE];
+        int32 pointCount = 0;
+        status = query->findStraightPath(start, end, polys, polyCount, straight, nullptr, nullptr, &pointCount, MAX_LEG_POINTS);
+        if (dtStatusFailed(status) || pointCount <= 0)
+            return;
+
+        leg.cost = 0.0f;
+        G3D::Vector3 prev = from;
+        for (int32 i = 1; i < pointCount; ++i)
+        {
+            G3D::Vector3 point = ToWorld(&straight[i * VERTEX_SIZE]);
+            leg.cost += (point - prev).length();
+            leg.points.push_back(point);
+            prev = point;
+        }
+    }
+}
+
+bool BotPathPlanner::PlanRoute(Unit const* unit, Position const& dest, std::vector<Position>& points, bool& complete)
+{
+    points.clear();
+    complete = false;
+
+    Map const* map = unit->GetMap();
+    if (!map->GetEntry()->IsContinent() || !DisableMgr::IsPathfindingEnabled(map->GetId()))
+        return false;
+    if (unit->GetExactDist2d(dest) <= ROUTE_POINT_SPACING)
+        return false;
+
+    dtNavMeshQuery const* query = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMeshQuery(map->GetId(), map->GetInstanceId());
+    if (!query)
+        return false;
+
+    NavGraph* graph;
+    {
+        std::lock_guard<std::mutex> lock(_graphsLock);
+        graph = &_graphs[map->GetId()];
+    }
+
+    std::lock_guard<std::mutex> graphLock(graph->lock);
+
+    if (graph->navMesh != query->getAttachedNavMesh() || graph->deadPortals > MAX_DEAD_PORTALS)
+        graph->Reset(query->getAttachedNavMesh());
+
+    dtQueryFilter filter;
+    filter.setIncludeFlags(NAV_GROUND | NAV_WATER);
+    filter.setExcludeFlags(0);
+
+    G3D::Vector3 const startPos(unit->GetPositionX(), unit->GetPositionY(), unit->GetPositionZ());
+    G3D::Vector3 const goalPos(dest.GetPositionX(), dest.GetPositionY(), dest.GetPositionZ());
+    float start[VERTEX_SIZE];
+    float goal[VERTEX_SIZE];
+    ToDetour(startPos, start);
+    ToDetour(goalPos, goal);
+
+    dtPolyRef startPoly = INVALID_POLYREF;
+    dtPolyRef goalPoly = INVALID_POLYREF;
+    float nearest[VERTEX_SIZE];
+    if (dtStatusFailed(query->findNearestPoly(start, POLY_SEARCH_EXTENTS, &filter, &startPoly, nearest)) || startPoly == INVALID_POLYREF)
+        return false;
+
+    int32 startTx, startTy, goalTx, goalTy;
+    graph->navMesh->calcTileLoc(start, &startTx, &startTy);
+    graph->navMesh->calcTileLoc(goal, &goalTx, &goalTy);
+    uint32 const startTile = MakeTileKey(startTx, startTy);
+    uint32 const goalTile = MakeTileKey(goalTx, goalTy);
+    //goal tile may not be loaded yet, plan towards it as far as possible then
+    if (graph->GetTile(goalTx, goalTy))
+        query->findNearestPoly(goal, POLY_SEARCH_EXTENTS, &filter, &goalPoly, nearest);
+
+    auto node_pos = [&](uint32 node) -> G3D::Vector3 const& {
+        return node == NODE_START ? startPos : node == NODE_GOAL ? goalPos : graph->portals[node].pos;
+    };
+    auto node_tile = [&](uint32 node) -> uint32 {
+        return node == NODE_START ? startTile : node == NODE_GOAL ? goalTile : graph->portals[node].tile;
+    };
+
+    //legs touching start or goal are route specific
+    std::unordered_map<uint64, Leg> localLegs;
+    uint32 queries = 0;
+    auto get_leg = [&](uint32 from, uint32 to) -> Leg const* {
+        uint64 const key = MakeLegKey(from, to);
+        bool const shared = from != NODE_START && to != NODE_GOAL;
+        std::unordered_map<uint64, Leg>& store = shared ? graph->legs : localLegs;
+        auto itr = store.find(key);
+        if (itr != store.end())
+            return &itr->second;
+
+        Leg leg;
+        if (shared && node_tile(from) != node_tile(to))
+        {
+            leg.cost = (node_pos(to) - node_pos(from)).length();
+            leg.points.push_back(node_pos(to));
+        }
+        else
+        {
+            if (queries >= MAX_LEG_QUERIES)
+                return nullptr;
+            ++queries;
+            dtPolyRef const fromPoly = from == NODE_START ? startPoly : graph->portals[from].poly;
+            dtPolyRef const toPoly = to == NODE_GOAL ? goalPoly : graph->portals[to].poly;
+            ComputeLeg(query, filter, fromPoly, node_pos(from), toPoly, node_pos(to), leg);
+        }
+        return &store.emplace(key, std::move(leg)).first->second;
+    };
+
+    struct SearchEntry
+    {
+        float f, g, parentG;
+        uint32 node, parent;
+        bool validated;
+        bool operator<(SearchEntry const& other) const { return f > other.f; }
+    };
+    struct SearchNode
+    {
+        uint32 parent;
+        float g;
+    };
+
+    std::priority_queue<SearchEntry> open;
+    std::unordered_map<uint32, SearchNode> closed;
+    auto push = [&](uint32 node, uint32 parent, float parentG) {
+        if (closed.find(node) != closed.end())
+            return;
+        //optimistic cost, replaced with actual leg cost when popped
+        float g = parentG + (node_pos(node) - node_pos(parent)).length();
+        open.push({ g + (goalPos - node_pos(node)).length(), g, parentG, node, parent, false });
+    };
+
+    open.push({ (goalPos - startPos).length(), 0.0f, 0.0f, NODE_START, NODE_START, true });
+    uint32 best = NODE_START;
+    float bestDist = (goalPos - startPos).length();
+    uint32 expanded = 0;
+    while (!open.empty() && expanded < MAX_EXPANDED_NODES)
+    {
+        SearchEntry entry = open.top();
+        open.pop();
+        if (closed.find(entry.node) != closed.end())
+            continue;
+        if (entry.node != NODE_START && entry.node != NODE_GOAL && graph->portals[entry.node].dead)
+            continue;
+
+        if (!entry.validated)
+        {
+            Leg const* leg = get_leg(entry.parent, entry.node);
+            if (!leg || leg->cost < 0.0f)
+                continue;
+            entry.g = entry.parentG + leg->cost;
+            entry.f = entry.g + (goalPos - node_pos(entry.node)).length();
+            entry.validated = true;
+            open.push(entry);
+            continue;
+        }
+
+        closed[entry.node] = { entry.parent, entry.g };
+        ++expanded;
+        if (entry.node == NODE_GOAL)
+        {
+            best = NODE_GOAL;
+            break;
+        }
+
+        float dist = (goalPos - node_pos(entry.node)).length();
+        if (entry.node != NODE_START && dist < bestDist)
+        {
+            best = entry.node;
+            bestDist = dist;
+        }
+
+        uint32 const tile = node_tile(entry.node);
+        //legs alternate: inside a tile to one of its portals, then across the border
+        if (entry.node != NODE_START && node_tile(entry.parent) == tile)
+        {
+            uint32 partner = graph->FindPartner(entry.node);
+            if (partner != NODE_GOAL)
+                push(partner, entry.node, entry.g);
+        }
+        else if (TileInfo const* info = graph->GetTile(TileKeyX(tile), TileKeyY(tile)))
+        {
+            for (uint32 portal : info->portals)
+                if (portal != entry.node)
+                    push(portal, entry.node, entry.g);
+            if (tile == goalTile && goalPoly != INVALID_POLYREF)
+                push(NODE_GOAL, entry.node, entry.g);
+        }
+    }
+
+    if (best == NODE_START)
+        return false;
+
+    complete = best == NODE_GOAL;
+
+    std::vector<uint32> chain;
+    for (uint32 node = best; node != NODE_START; node = closed[node].parent)
+        chain.push_back(node);
+
+    G3D::Vector3 prev = startPos;
+    uint32 parent = NODE_START;
+    for (auto itr = chain.rbegin(); itr != chain.rend(); ++itr)
+    {
+        Leg const* leg = get_leg(parent, *itr);
+        ASSERT(leg && leg->cost >= 0.0f);
+        parent = *itr;
+
+        for (size_t i = 0; i < leg->points.size(); ++i)
+        {
+            G3D::Vector3 const& point = leg->points[i];
+            float const dist2d = G3D::Vector2(point.x - prev.x, point.y - prev.y).length();
+            bool const last = itr + 1 == chain.rend() && i + 1 == leg->points.size();
+            if (dist2d < ROUTE_POINT_MIN_SPACING && !last)
+                continue;
+
+            //split long straight segments, intermediate heights are taken from the map
+            uint32 const splits = uint32(dist2d / ROUTE_POINT_SPACING);
+            for (uint32 k = 1; k <= splits; ++k)
+            {
+                G3D::Vector3 mid = prev + (point - prev) * (float(k) / float(splits + 1));
+                float height = unit->GetMapHeight(mid.x, mid.y, mid.z + 5.0f);
+                if (height > INVALID_HEIGHT)
+                    mid.z = height;
+                points.emplace_back(mid.x, mid.y, mid.z);
+            }
+
+            points.emplace_back(point.x, point.y, point.z);
+            prev = point;
+        }
+    }
+
+    return !points.empty();
+}
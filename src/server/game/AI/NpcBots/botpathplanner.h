@@ -0,0 +1,27 @@
+#ifndef _BOT_PATHPLANNER_H
+#define _BOT_PATHPLANNER_H
+
+#include "Define.h"
+
+#include <vector>
+
+class Unit;
+
+struct Position;
+
+/*
+Long distance route planner for wandering bots.
+Navmesh tiles are abstracted into a graph of border portals (built once per loaded tile and cached per map),
+a route is searched over portals first and only the portal-to-portal legs along the way are refined with navmesh queries.
+Resulting points are spaced to be reachable with a single PathGenerator call each.
+Continent maps only, must be called from the owning map's update.
+*/
+class BotPathPlanner
+{
+    public:
+        //fills points from unit's position to dest (exclusive of start); complete is false if route ends short of dest
+        //returns false if no route could be planned or dest is close enough for direct pathing
+        static bool PlanRoute(Unit const* unit, Position const& dest, std::vector<Position>& points, bool& complete);
+};
+
+#endif
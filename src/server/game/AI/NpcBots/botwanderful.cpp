@@ -19,6 +19,7 @@ WanderNode::node_ltype WanderNode::ALL_WPS = {};
 WanderNode::node_mtype WanderNode::ALL_WPS_PER_MAP = {};
 WanderNode::node_mtype WanderNode::ALL_WPS_PER_ZONE = {};
 WanderNode::node_mtype WanderNode::ALL_WPS_PER_AREA = {};
+WanderNode::node_rtmtype WanderNode::ROUTING_TABLES_PER_MAP = {};
 
 WanderNode::mutex_type* WanderNode::GetLock()
 {
@@ -174,6 +175,93 @@ size_t WanderNode::GetWPMapsCount()
     return ALL_WPS_PER_MAP.size();
 }
 
+void WanderNode::BuildRoutingTables(std::function<bool(uint32 /*mapId*/)> const& pred)
+{
+    lock_type lock(*GetLock());
+
+    for (node_mtype::value_type const& kv : ALL_WPS_PER_MAP)
+        if (pred(kv.first))
+            GetRoutingTable(kv.first);
+}
+
+WanderNode::RoutingTable const& WanderNode::GetRoutingTable(uint32 mapId)
+{
+    lock_type lock(*GetLock());
+
+    node_rtmtype::const_iterator rci = ROUTING_TABLES_PER_MAP.find(mapId);
+    if (rci != ROUTING_TABLES_PER_MAP.cend())
+        return rci->second;
+
+    RoutingTable& table = ROUTING_TABLES_PER_MAP[mapId];
+    node_mtype::const_iterator ci = ALL_WPS_PER_MAP.find(mapId);
+    if (ci == ALL_WPS_PER_MAP.cend())
+        return table;
+
+    node_ltype const& wps = ci->second;
+    size_t const size = wps.size();
+    table.indexes.reserve(size);
+    for (WanderNode const* wp : wps)
+        table.indexes.emplace(wp, uint32(table.indexes.size()));
+
+    std::vector<std::vector<uint32>> adjacency(size);
+    for (WanderNode const* wp : wps)
+    {
+        std::vector<uint32>& adj = adjacency[table.indexes.at(wp)];
+        for (WanderNodeLink const& wpl : wp->GetLinks())
+        {
+            auto lci = table.indexes.find(wpl.wp);
+            if (lci != table.indexes.cend())
+                adj.push_back(lci->second);
+        }
+    }
+
+    //breadth-first from every node, links are one-way
+    table.hops.assign(size * size, RoutingTable::UNREACHABLE);
+    std::vector<uint32> frontier;
+    std::vector<uint32> frontier_new;
+    for (size_t from = 0; from != size; ++from)
+    {
+        uint16* row = &table.hops[from * size];
+        row[from] = 0;
+        frontier.assign(1, uint32(from));
+        for (uint16 level = 1; !frontier.empty() && level != RoutingTable::UNREACHABLE; ++level)
+        {
+            frontier_new.clear();
+            for (uint32 i : frontier)
+            {
+                for (uint32 j : adjacency[i])
+                {
+                    if (row[j] == RoutingTable::UNREACHABLE)
+                    {
+                        row[j] = level;
+                        frontier_new.push_back(j);
+                    }
+                }
+            }
+            frontier.swap(frontier_new);
+        }
+    }
+
+    return table;
+}
+
+void WanderNode::InvalidateRoutingTable(uint32 mapId)
+{
+    lock_type lock(*GetLock());
+
+    ROUTING_TABLES_PER_MAP.erase(mapId);
+}
+
+uint16 WanderNode::RoutingTable::GetHops(WanderNode const* from, WanderNode const* to) const
+{
+    auto fci = indexes.find(from);
+    auto tci = indexes.find(to);
+    if (fci == indexes.cend() || tci == indexes.cend())
+        return UNREACHABLE;
+
+    return hops[size_t(fci->second) * indexes.size() + tci->second];
+}
+
 WanderNode::WanderNode(uint32 wpId, uint32 mapId, float x, float y, float z, float o, uint32 zoneId, uint32 areaId, std::string const& name)
     : Position(x, y, z, o),
     _wpId(wpId), _mapId(mapId), _zoneId(zoneId), _areaId(areaId), _name(name), _minLevel(1u), _maxLevel(DEFAULT_MAX_LEVEL), _flags(0), _to_links_count(0),
@@ -189,6 +277,7 @@ WanderNode::WanderNode(uint32 wpId, uint32 mapId, float x, float y, float z, flo
     ALL_WPS_PER_MAP[_mapId].push_back(this);
     ALL_WPS_PER_ZONE[_zoneId].push_back(this);
     ALL_WPS_PER_AREA[_areaId].push_back(this);
+    InvalidateRoutingTable(_mapId);
 }
 
 WanderNode::~WanderNode()
@@ -208,6 +297,7 @@ void WanderNode::RemoveWP(WanderNode* wp)
     ALL_WPS_PER_ZONE.at(wp->_zoneId).remove(wp);
     ALL_WPS_PER_MAP.at(wp->_mapId).remove(wp);
     ALL_WPS.remove(wp);
+    InvalidateRoutingTable(wp->_mapId);
 
     //WE LET THE NODE LEAK for threadsafety
     //delete wp
@@ -224,7 +314,6 @@ void WanderNode::RemoveAllWPs()
 WanderNode::node_lltype WanderNode::GetShortestPathLinks(WanderNode const* target, WanderNode::node_lltype const& base_links, BotWPLevel max_level_diff) const
 {
     using NodeLinkList = WanderNode::node_lltype;
-    using NodeLinkPList = std::vector<WanderNodeLink const*>;
 
     ASSERT(std::all_of(base_links.cbegin(), base_links.cend(), [this](WanderNodeLink const& wpl) { return HasLink(wpl.Id()); }));
 
@@ -233,6 +322,9 @@ WanderNode::node_lltype WanderNode::GetShortestPathLinks(WanderNode const* targe
         retlist.push_back(WanderNodeLink{ .wp = const_cast<WanderNode*>(this), .weight = 10000 });
     else
     {
+        lock_type lock(*GetLock());
+
+        RoutingTable const& table = GetRoutingTable(GetMapId());
         std::list<std::pair<uint32 /*level*/, WanderNodeLink const*>> validLinks;
         for (WanderNodeLink const& link : base_links)
         {
@@ -246,33 +338,20 @@ WanderNode::node_lltype WanderNode::GetShortestPathLinks(WanderNode const* targe
             if (max_level_diff != BotWPLevel::BOTWP_LEVEL_ZERO && link.wp->GetLinks().size() == 1 && link.wp->GetLinks().front().wp == this)
                 continue;
 
-            std::unordered_set<uint32> checked_links;
-            checked_links.insert(GetWPId());
-            NodeLinkPList vlinks_cur;
-            NodeLinkList clinks;
-            clinks.push_back(link);
-            for (uint32 level = 0; !clinks.empty(); ++level)
+            uint32 hops = table.GetHops(link.wp, target);
+            if (hops == RoutingTable::UNREACHABLE)
+                continue;
+
+            //shortest route leads back through this node, find one that doesn't (cut off all ways back)
+            if (uint32(table.GetHops(link.wp, this)) + table.GetHops(this, target) == hops)
             {
-                for (WanderNodeLink const& wpl : clinks)
-                {
-                    if (wpl.wp->HasLink(target))
-                        vlinks_cur.push_back(&link);
-                }
-                if (!vlinks_cur.empty())
-                {
-                    validLinks.emplace_back(level, &link);
-                    break;
-                }
-                decltype(clinks) clinks_new;
-                for (WanderNodeLink const& wpl : clinks)
-                {
-                    checked_links.insert(wpl.Id()); // cut off all ways back (2-ways, circular)
-                    std::copy_if(wpl.wp->GetLinks().cbegin(), wpl.wp->GetLinks().cend(), std::back_inserter(clinks_new), [&checked_links](WanderNodeLink const& wpl) {
-                        return !checked_links.contains(wpl.Id());
-                    });
-                }
-                clinks = std::move(clinks_new);
+                hops = _getHopsAvoidingSelf(table, link.wp, target);
+                if (hops == RoutingTable::UNREACHABLE)
+                    continue;
             }
+
+            //level 0: link leads to a node linked to target
+            validLinks.emplace_back(hops - 1, &link);
         }
 
         if (!validLinks.empty())
@@ -296,6 +375,37 @@ WanderNode::node_lltype WanderNode::GetShortestPathLinks(WanderNode const* targe
     return retlist;
 }
 
+uint32 WanderNode::_getHopsAvoidingSelf(RoutingTable const& table, WanderNode const* from, WanderNode const* target) const
+{
+    //routes longer than the shortest one (which may lead through this node) by more than MAX_DETOUR_HOPS are not searched.
+    //table hops never overestimate, so nodes that can't reach target within the limit are not expanded
+    static constexpr uint32 MAX_DETOUR_HOPS = 8;
+    uint32 const max_level = table.GetHops(from, target) + MAX_DETOUR_HOPS;
+
+    std::unordered_set<WanderNode const*> checked_nodes{ this, from };
+    std::vector<WanderNode const*> frontier{ from };
+    std::vector<WanderNode const*> frontier_new;
+    for (uint32 level = 1; !frontier.empty() && level <= max_level; ++level)
+    {
+        frontier_new.clear();
+        for (WanderNode const* wp : frontier)
+        {
+            for (WanderNodeLink const& wpl : wp->GetLinks())
+            {
+                if (wpl.wp == target)
+                    return level;
+                if (level + table.GetHops(wpl.wp, target) > max_level)
+                    continue;
+                if (checked_nodes.insert(wpl.wp).second)
+                    frontier_new.push_back(wpl.wp);
+            }
+        }
+        frontier.swap(frontier_new);
+    }
+
+    return RoutingTable::UNREACHABLE;
+}
+
 void WanderNode::SetCreature(Creature* creature)
 {
     if (creature != nullptr)
@@ -394,6 +504,7 @@ void WanderNode::Link(WanderNodeLink&& wpl)
         _links.push_back(std::move(wpl));
         wpl.wp->_setLinkedBy(this);
         SetupLinkFromAura();
+        InvalidateRoutingTable(_mapId);
     }
 }
 void WanderNode::UnLink(uint32 wp_id)
@@ -405,6 +516,7 @@ void WanderNode::UnLink(uint32 wp_id)
         _links.erase(lit);
         lwp->_setUnLinkedBy(this);
         SetupLinkFromAura();
+        InvalidateRoutingTable(_mapId);
     }
 }
 void WanderNode::_setLinkedBy(WanderNode const*/* lwp*/)
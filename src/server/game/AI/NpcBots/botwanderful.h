@@ -3,11 +3,13 @@
 
 #include "Position.h"
 
+#include <algorithm>
 #include <functional>
 #include <list>
 #include <mutex>
 #include <shared_mutex>
 #include <unordered_map>
+#include <vector>
 
 /*
 NpcBot System by Trickerer (onlysuffering@gmail.com)
@@ -105,6 +107,23 @@ private:
     static node_mtype ALL_WPS_PER_ZONE;
     static node_mtype ALL_WPS_PER_AREA;
 
+    //hop counts between every pair of nodes of a map, built on demand and dropped on any change of the map's graph
+    struct RoutingTable
+    {
+        static constexpr uint16 UNREACHABLE = 0xFFFF;
+
+        uint16 GetHops(WanderNode const* from, WanderNode const* to) const;
+
+        std::unordered_map<WanderNode const*, uint32> indexes;
+        std::vector<uint16> hops; // [from * size + to]
+    };
+    using node_rtmtype = std::unordered_map<uint32, RoutingTable>;
+
+    static node_rtmtype ROUTING_TABLES_PER_MAP;
+
+    static RoutingTable const& GetRoutingTable(uint32 mapId);
+    static void InvalidateRoutingTable(uint32 mapId);
+
     template<class T, typename = void>
     struct is_container : std::false_type {};
     template<class T>
@@ -149,6 +168,7 @@ public:
     static size_t GetAllWPsCount();
     static size_t GetMapWPsCount(uint32 mapId);
     static size_t GetWPMapsCount();
+    static void BuildRoutingTables(std::function<bool(uint32 /*mapId*/)> const& pred);
 
     WanderNode(uint32 wpId, uint32 mapId, float x, float y, float z, float o, uint32 zoneId, uint32 areaId, std::string const& name);
     ~WanderNode();
@@ -211,6 +231,7 @@ public:
 private:
     void _setLinkedBy(WanderNode const*/* lwp*/);
     void _setUnLinkedBy(WanderNode const*/* lwp*/);
+    uint32 _getHopsAvoidingSelf(RoutingTable const& table, WanderNode const* from, WanderNode const* target) const;
 
     uint32 _wpId;
     const uint32 _mapId;
@@ -2775,7 +2775,6 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player co
         return;
 
     bool forcedFlags = GetGoType() == GAMEOBJECT_TYPE_CHEST && GetGOInfo()->chest.groupLootRules && HasLootRecipient();
-    bool targetIsGM = target->IsGameMaster();
 
     ByteBuffer fieldBuffer;
 
@@ -2794,53 +2793,8 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player co
         {
             updateMask.SetBit(index);
 
-            if (index == GAMEOBJECT_DYNAMIC)
-            {
-                uint16 dynFlags = 0;
-                int16 pathProgress = -1;
-                switch (GetGoType())
-                {
-                    case GAMEOBJECT_TYPE_QUESTGIVER:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_CHEST:
-                    case GAMEOBJECT_TYPE_GOOBER:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
-                        else if (targetIsGM)
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_GENERIC:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_SPARKLE;
-                        break;
-                    case GAMEOBJECT_TYPE_TRANSPORT:
-                    case GAMEOBJECT_TYPE_MO_TRANSPORT:
-                    {
-                        if (uint32 transportPeriod = GetTransportPeriod())
-                        {
-                            float timer = float(m_goValue.Transport.PathProgress % transportPeriod);
-                            pathProgress = int16(timer / float(transportPeriod) * 65535.0f);
-                        }
-                        break;
-                    }
-                    default:
-                        break;
-                }
-
-                fieldBuffer << uint16(dynFlags);
-                fieldBuffer << int16(pathProgress);
-            }
-            else if (index == GAMEOBJECT_FLAGS)
-            {
-                uint32 goFlags = m_uint32Values[GAMEOBJECT_FLAGS];
-                if (GetGoType() == GAMEOBJECT_TYPE_CHEST)
-                    if (GetGOInfo()->chest.groupLootRules && !IsLootAllowedFor(target))
-                        goFlags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
-
-                fieldBuffer << goFlags;
-            }
+            if (IsValuesUpdateFieldTargetDependent(index))
+                fieldBuffer << GetValuesUpdateFieldForTarget(index, target);
             else
                 fieldBuffer << m_uint32Values[index];                // other cases
         }
@@ -2850,6 +2804,64 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player co
     data->append(fieldBuffer);
 }
 
+bool GameObject::IsValuesUpdateFieldTargetDependent(uint16 index) const
+{
+    return index == GAMEOBJECT_DYNAMIC || index == GAMEOBJECT_FLAGS;
+}
+
+uint32 GameObject::GetValuesUpdateFieldForTarget(uint16 index, Player const* target) const
+{
+    if (index == GAMEOBJECT_DYNAMIC)
+    {
+        uint16 dynFlags = 0;
+        int16 pathProgress = -1;
+        switch (GetGoType())
+        {
+            case GAMEOBJECT_TYPE_QUESTGIVER:
+                if (ActivateToQuest(target))
+                    dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                break;
+            case GAMEOBJECT_TYPE_CHEST:
+            case GAMEOBJECT_TYPE_GOOBER:
+                if (ActivateToQuest(target))
+                    dynFlags |= GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+                else if (target->IsGameMaster())
+                    dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                break;
+            case GAMEOBJECT_TYPE_GENERIC:
+                if (ActivateToQuest(target))
+                    dynFlags |= GO_DYNFLAG_LO_SPARKLE;
+                break;
+            case GAMEOBJECT_TYPE_TRANSPORT:
+            case GAMEOBJECT_TYPE_MO_TRANSPORT:
+            {
+                if (uint32 transportPeriod = GetTransportPeriod())
+                {
+                    float timer = float(m_goValue.Transport.PathProgress % transportPeriod);
+                    pathProgress = int16(timer / float(transportPeriod) * 65535.0f);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+
+        // sent as two 16 bit values, flags first
+        return uint32(dynFlags) | (uint32(uint16(pathProgress)) << 16);
+    }
+    else if (index == GAMEOBJECT_FLAGS)
+    {
+        uint32 goFlags = m_uint32Values[GAMEOBJECT_FLAGS];
+        if (GetGoType() == GAMEOBJECT_TYPE_CHEST)
+            if (GetGOInfo()->chest.groupLootRules && !IsLootAllowedFor(target))
+                goFlags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
+
+        return goFlags;
+    }
+
+    return m_uint32Values[index];
+}
+
 void GameObject::GetRespawnPosition(float &x, float &y, float &z, float* ori /* = nullptr*/) const
 {
     if (m_goData)
@@ -89,6 +89,8 @@ class TC_GAME_API GameObject : public WorldObject, public GridObject<GameObject>
         ~GameObject();
 
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player const* target) const override;
+        bool IsValuesUpdateFieldTargetDependent(uint16 index) const override;
+        uint32 GetValuesUpdateFieldForTarget(uint16 index, Player const* target) const override;
 
         void AddToWorld() override;
         void RemoveFromWorld() override;
@@ -508,10 +508,64 @@ void Object::ClearUpdateMask(bool remove)
     }
 }
 
-void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) const
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, ValuesUpdateBlockCache* cache) const
 {
     UpdateDataMapType::iterator iter = data_map.try_emplace(player).first;
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    if (cache)
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first, *cache);
+    else
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+}
+
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player const* target, ValuesUpdateBlockCache& cache) const
+{
+    uint32* flags = nullptr;
+    uint32 visibleFlag = GetUpdateFieldData(target, flags);
+
+    ByteBuffer& buf = data->GetBuffer();
+    buf << uint8(UPDATETYPE_VALUES);
+    buf << GetPackGUID();
+
+    auto itr = std::find_if(cache.Blocks.begin(), cache.Blocks.end(), [visibleFlag](ValuesUpdateBlockCache::Block const& block)
+    {
+        return block.VisibleFlag == visibleFlag;
+    });
+
+    if (itr == cache.Blocks.end())
+    {
+        ValuesUpdateBlockCache::Block& block = cache.Blocks.emplace_back();
+        block.VisibleFlag = visibleFlag;
+        BuildValuesUpdate(UPDATETYPE_VALUES, &block.Data, target);
+
+        // every field takes 4 bytes, find where the observer dependent ones ended up
+        uint8 maskBlocks = block.Data.read<uint8>(0);
+        size_t pos = sizeof(uint8) + maskBlocks * sizeof(UpdateMaskPacketBuilder::ClientUpdateMaskType);
+        for (uint8 i = 0; i < maskBlocks; ++i)
+        {
+            uint32 mask = block.Data.read<uint32>(sizeof(uint8) + i * sizeof(UpdateMaskPacketBuilder::ClientUpdateMaskType));
+            for (uint16 bit = 0; mask; ++bit, mask >>= 1)
+            {
+                if (!(mask & 1))
+                    continue;
+
+                uint16 index = i * UpdateMaskPacketBuilder::CLIENT_UPDATE_MASK_BITS + bit;
+                if (IsValuesUpdateFieldTargetDependent(index))
+                    block.TargetFields.emplace_back(index, pos);
+                pos += sizeof(uint32);
+            }
+        }
+
+        buf.append(block.Data);
+    }
+    else
+    {
+        size_t start = buf.wpos();
+        buf.append(itr->Data);
+        for (auto const& [index, pos] : itr->TargetFields)
+            buf.put<uint32>(start + pos, GetValuesUpdateFieldForTarget(index, target));
+    }
+
+    data->AddUpdateBlock();
 }
 
 uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
@@ -543,6 +597,10 @@ uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
 
             if (plr && plr->IsInSameRaidWith(target))
                 visibleFlag |= UF_FLAG_PARTY_MEMBER;
+            //npcbot
+            else if (ToUnit()->IsNPCBotOrPet() && ToUnit()->IsInRaidWith(target))
+                visibleFlag |= UF_FLAG_PARTY_MEMBER;
+            //end npcbot
             break;
         }
         case TYPEID_GAMEOBJECT:
@@ -3673,6 +3731,9 @@ void WorldObject::SetPhaseMask(uint32 newPhaseMask, bool update)
 {
     m_phaseMask = newPhaseMask;
 
+    if (IsInWorld())
+        GetMap()->InvalidateCellObjectIndex(Cell(GetPositionX(), GetPositionY()));
+
     if (update && IsInWorld())
         UpdateObjectVisibility();
 }
@@ -3744,6 +3805,7 @@ struct WorldObjectChangeAccumulator
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
     GuidSet plr_list;
+    ValuesUpdateBlockCache i_valuesCache;
     WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj) { }
     void Visit(PlayerMapType &m)
     {
@@ -3801,7 +3863,7 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (plr_list.find(player->GetGUID()) == plr_list.end() && player->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(player, i_updateDatas);
+            i_object.BuildFieldsUpdate(player, i_updateDatas, &i_valuesCache);
             plr_list.insert(player->GetGUID());
         }
     }
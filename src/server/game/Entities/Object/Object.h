@@ -36,6 +36,7 @@
 #include <list>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 class Corpse;
 class Creature;
@@ -62,6 +63,20 @@ struct QuaternionData;
 
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 
+// Values update blocks of one object, built once per visibility class of its observers and reused for
+// every observer of that class. Only valid while the object does not change, i.e. during a single BuildUpdate
+struct ValuesUpdateBlockCache
+{
+    struct Block
+    {
+        uint32 VisibleFlag = 0;
+        ByteBuffer Data;                                        // update mask and values, without block header
+        std::vector<std::pair<uint16, size_t>> TargetFields;    // index and position in Data of fields built per observer
+    };
+
+    std::vector<Block> Blocks;
+};
+
 float const DEFAULT_COLLISION_HEIGHT = 2.03128f; // Most common value in dbc
 
 class TC_GAME_API Object
@@ -155,7 +170,7 @@ class TC_GAME_API Object
         virtual bool hasInvolvedQuest(uint32 /* quest_id */) const { return false; }
         void SetIsNewObject(bool enable) { m_isNewObject = enable; }
         virtual void BuildUpdate(UpdateDataMapType&) { }
-        void BuildFieldsUpdate(Player*, UpdateDataMapType &) const;
+        void BuildFieldsUpdate(Player*, UpdateDataMapType &, ValuesUpdateBlockCache* cache = nullptr) const;
 
         void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; }
         void RemoveFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags &= uint16(~flag); }
@@ -233,6 +248,10 @@ class TC_GAME_API Object
 
         void BuildMovementUpdate(ByteBuffer* data, uint16 flags) const;
         virtual void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player const* target) const;
+        // fields whose sent value depends on the observer beyond its visibility class
+        virtual bool IsValuesUpdateFieldTargetDependent(uint16 /*index*/) const { return false; }
+        virtual uint32 GetValuesUpdateFieldForTarget(uint16 index, Player const* /*target*/) const { return m_uint32Values[index]; }
+        void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player const* target, ValuesUpdateBlockCache& cache) const;
 
         uint16 m_objectType;
 
@@ -0,0 +1,124 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "UpdateCompressor.h"
+#include "Log.h"
+#include <algorithm>
+#include <zlib.h>
+
+namespace
+{
+    class ZStreamContext
+    {
+    public:
+        ZStreamContext() : _initialized(false), _level(0)
+        {
+            _stream.zalloc = (alloc_func)nullptr;
+            _stream.zfree = (free_func)nullptr;
+            _stream.opaque = (voidpf)nullptr;
+        }
+
+        ~ZStreamContext()
+        {
+            if (_initialized)
+                deflateEnd(&_stream);
+        }
+
+        ZStreamContext(ZStreamContext const&) = delete;
+        ZStreamContext& operator=(ZStreamContext const&) = delete;
+
+        // stream ready to deflate a new payload with given level, nullptr on failure
+        z_stream* Acquire(int level)
+        {
+            // deflateParams may flush into next_out, which still points to the previous packet's buffer
+            // (zlib 1.2.9 - 1.2.11 even after deflateReset), start a new stream instead
+            if (_initialized && level != _level)
+                Discard();
+
+            if (!_initialized)
+            {
+                int z_res = deflateInit(&_stream, level);
+                if (z_res != Z_OK)
+                {
+                    TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflateInit) Error code: {} ({})", z_res, zError(z_res));
+                    return nullptr;
+                }
+
+                _initialized = true;
+                _level = level;
+                return &_stream;
+            }
+
+            int z_res = deflateReset(&_stream);
+            if (z_res != Z_OK)
+            {
+                TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflateReset) Error code: {} ({})", z_res, zError(z_res));
+                Discard();
+                return nullptr;
+            }
+
+            return &_stream;
+        }
+
+        // drops zlib state after an error, next Acquire starts from scratch
+        void Discard()
+        {
+            if (_initialized)
+                deflateEnd(&_stream);
+            _initialized = false;
+        }
+
+    private:
+        z_stream _stream;
+        bool _initialized;
+        int _level;
+    };
+
+    thread_local ZStreamContext StreamContext;
+}
+
+int UpdateCompressor::SelectLevel(std::size_t srcSize, int configuredLevel)
+{
+    // large payloads come in bursts (zone-in, mass spawns), keep them cheap
+    if (srcSize >= LARGE_PAYLOAD_SIZE)
+        return std::min(configuredLevel, Z_BEST_SPEED);
+
+    return configuredLevel;
+}
+
+uint32 UpdateCompressor::Compress(void* dst, uint32 dstSize, void const* src, uint32 srcSize, int level)
+{
+    z_stream* c_stream = StreamContext.Acquire(level);
+    if (!c_stream)
+        return 0;
+
+    c_stream->next_out = (Bytef*)dst;
+    c_stream->avail_out = dstSize;
+    c_stream->next_in = (Bytef*)src;
+    c_stream->avail_in = (uInt)srcSize;
+
+    // whole payload is available, finish in a single call
+    int z_res = deflate(c_stream, Z_FINISH);
+    if (z_res != Z_STREAM_END)
+    {
+        TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflate should report Z_STREAM_END instead {} ({})", z_res, zError(z_res));
+        StreamContext.Discard();
+        return 0;
+    }
+
+    return uint32(c_stream->total_out);
+}
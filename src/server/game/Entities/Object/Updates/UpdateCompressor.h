@@ -0,0 +1,41 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_UPDATECOMPRESSOR_H
+#define TRINITY_UPDATECOMPRESSOR_H
+
+#include "Define.h"
+#include <cstddef>
+
+// Deflates SMSG_COMPRESSED_UPDATE_OBJECT payloads
+// Every thread keeps its own zlib stream alive and resets it between packets instead of
+// allocating new zlib state for each one
+class TC_GAME_API UpdateCompressor
+{
+    public:
+        // payloads this large are deflated with Z_BEST_SPEED regardless of configured level
+        static constexpr std::size_t LARGE_PAYLOAD_SIZE = 16 * 1024;
+
+        // compression level used for a payload of given size
+        static int SelectLevel(std::size_t srcSize, int configuredLevel);
+
+        // dstSize should be at least compressBound(srcSize)
+        // return: compressed size, 0 on failure
+        static uint32 Compress(void* dst, uint32 dstSize, void const* src, uint32 srcSize, int level);
+};
+
+#endif
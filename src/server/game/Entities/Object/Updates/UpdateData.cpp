@@ -17,8 +17,8 @@
 
 #include "UpdateData.h"
 #include "Errors.h"
-#include "Log.h"
 #include "Opcodes.h"
+#include "UpdateCompressor.h"
 #include "World.h"
 #include "WorldPacket.h"
 #include <zlib.h>
@@ -35,60 +35,12 @@ void UpdateData::AddOutOfRangeGUID(ObjectGuid guid)
     m_outOfRangeGUIDs.insert(guid);
 }
 
-void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
+void UpdateData::Append(UpdateData&& right)
 {
-    z_stream c_stream;
-
-    c_stream.zalloc = (alloc_func)nullptr;
-    c_stream.zfree = (free_func)nullptr;
-    c_stream.opaque = (voidpf)nullptr;
-
-    // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld->getIntConfig(CONFIG_COMPRESSION));
-    if (z_res != Z_OK)
-    {
-        TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflateInit) Error code: {} ({})", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
-
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
-    if (z_res != Z_OK)
-    {
-        TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflate) Error code: {} ({})", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
-    if (c_stream.avail_in != 0)
-    {
-        TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflate not greedy)");
-        *dst_size = 0;
-        return;
-    }
-
-    z_res = deflate(&c_stream, Z_FINISH);
-    if (z_res != Z_STREAM_END)
-    {
-        TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflate should report Z_STREAM_END instead {} ({})", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflateEnd) Error code: {} ({})", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
-    *dst_size = c_stream.total_out;
+    m_blockCount += right.m_blockCount;
+    m_outOfRangeGUIDs.insert(right.m_outOfRangeGUIDs.begin(), right.m_outOfRangeGUIDs.end());
+    m_data.append(right.m_data);
+    right.Clear();
 }
 
 bool UpdateData::BuildPacket(WorldPacket* packet)
@@ -118,7 +70,8 @@ bool UpdateData::BuildPacket(WorldPacket* packet)
         packet->resize(destsize + sizeof(uint32));
 
         packet->put<uint32>(0, pSize);
-        Compress(const_cast<uint8*>(packet->contents()) + sizeof(uint32), &destsize, (void*)buf.contents(), pSize);
+        destsize = UpdateCompressor::Compress(const_cast<uint8*>(packet->contents()) + sizeof(uint32), destsize, buf.contents(), pSize,
+            UpdateCompressor::SelectLevel(pSize, sWorld->getIntConfig(CONFIG_COMPRESSION)));
         if (destsize == 0)
             return false;
 
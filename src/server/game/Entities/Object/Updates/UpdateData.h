@@ -63,6 +63,7 @@ class UpdateData
         void AddOutOfRangeGUID(GuidSet& guids);
         void AddOutOfRangeGUID(ObjectGuid guid);
         void AddUpdateBlock() { ++m_blockCount; }
+        void Append(UpdateData&& right);
         ByteBuffer& GetBuffer() { return m_data; }
         bool BuildPacket(WorldPacket* packet);
         bool HasData() const { return m_blockCount > 0 || !m_outOfRangeGUIDs.empty(); }
@@ -75,8 +76,6 @@ class UpdateData
         GuidSet m_outOfRangeGUIDs;
         ByteBuffer m_data;
 
-        void Compress(void* dst, uint32 *dst_size, void* src, int src_size);
-
         UpdateData(UpdateData const& right) = delete;
         UpdateData& operator=(UpdateData const& right) = delete;
 };
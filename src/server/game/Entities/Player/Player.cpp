@@ -6380,6 +6380,11 @@ void Player::SendDirectMessage(WorldPacket const* data) const
     m_session->SendPacket(data);
 }
 
+void Player::SendDirectMessage(std::shared_ptr<WorldPacket const> const& data) const
+{
+    m_session->SendPacket(data);
+}
+
 void Player::SendCinematicStart(uint32 CinematicSequenceId) const
 {
     WorldPackets::Misc::TriggerCinematic packet;
@@ -18319,10 +18324,15 @@ Item* Player::_LoadItem(CharacterDatabaseTransaction trans, uint32 zoneId, uint3
                     stmt->setUInt32(1, GetGUID().GetCounter());
                     if (PreparedQueryResult result = CharacterDatabase.Query(stmt))
                     {
-                        item->SetRefundRecipient((*result)[0].GetUInt32());
-                        item->SetPaidMoney((*result)[1].GetUInt32());
-                        item->SetPaidExtendedCost((*result)[2].GetUInt16());
-                        AddRefundReference(item->GetGUID());
+                        using ItemRefundRow = PreparedResultSchema<uint32, uint32, uint16>;
+                        if (ItemRefundRow::Validate(*result))
+                        {
+                            auto [refundRecipient, paidMoney, paidExtendedCost] = ItemRefundRow::GetRow(*result, 0);
+                            item->SetRefundRecipient(refundRecipient);
+                            item->SetPaidMoney(paidMoney);
+                            item->SetPaidExtendedCost(paidExtendedCost);
+                            AddRefundReference(item->GetGUID());
+                        }
                     }
                     else
                     {
@@ -18338,22 +18348,28 @@ Item* Player::_LoadItem(CharacterDatabaseTransaction trans, uint32 zoneId, uint3
                 stmt->setUInt32(0, item->GetGUID().GetCounter());
                 if (PreparedQueryResult result = CharacterDatabase.Query(stmt))
                 {
-                    GuidSet looters;
-                    for (std::string_view guidStr : Trinity::Tokenize((*result)[0].GetStringView(), ' ', false))
+                    using ItemBopTradeRow = PreparedResultSchema<std::string_view>;
+                    if (ItemBopTradeRow::Validate(*result))
                     {
-                        if (Optional<ObjectGuid::LowType> guid = Trinity::StringTo<ObjectGuid::LowType>(guidStr))
-                            looters.insert(ObjectGuid::Create<HighGuid::Player>(*guid));
-                        else
-                            TC_LOG_WARN("entities.player.loading", "Player::_LoadInventory: invalid item_soulbound_trade_data GUID '{}' for item {}. Skipped.", std::string(guidStr), item->GetGUID().ToString());
-                    }
+                        auto [allowedPlayers] = ItemBopTradeRow::GetRow(*result, 0);
 
-                    if (looters.size() > 1 && item->GetTemplate()->GetMaxStackSize() == 1 && item->IsSoulBound())
-                    {
-                        item->SetSoulboundTradeable(looters);
-                        AddTradeableItem(item);
+                        GuidSet looters;
+                        for (std::string_view guidStr : Trinity::Tokenize(allowedPlayers, ' ', false))
+                        {
+                            if (Optional<ObjectGuid::LowType> guid = Trinity::StringTo<ObjectGuid::LowType>(guidStr))
+                                looters.insert(ObjectGuid::Create<HighGuid::Player>(*guid));
+                            else
+                                TC_LOG_WARN("entities.player.loading", "Player::_LoadInventory: invalid item_soulbound_trade_data GUID '{}' for item {}. Skipped.", std::string(guidStr), item->GetGUID().ToString());
+                        }
+
+                        if (looters.size() > 1 && item->GetTemplate()->GetMaxStackSize() == 1 && item->IsSoulBound())
+                        {
+                            item->SetSoulboundTradeable(looters);
+                            AddTradeableItem(item);
+                        }
+                        else
+                            item->ClearSoulboundTradeable(this);
                     }
-                    else
-                        item->ClearSoulboundTradeable(this);
                 }
                 else
                 {
@@ -14375,28 +14375,10 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player const* t
 
     UpdateMaskPacketBuilder updateMask(m_valuesCount);
 
-    uint32* flags = UnitUpdateFieldFlags;
-    uint32 visibleFlag = UF_FLAG_PUBLIC;
+    uint32* flags = nullptr;
+    uint32 visibleFlag = GetUpdateFieldData(target, flags);
+    ASSERT(flags);
 
-    if (target == this)
-        visibleFlag |= UF_FLAG_PRIVATE;
-
-    Player* plr = GetCharmerOrOwnerPlayerOrPlayerItself();
-    if (GetOwnerGUID() == target->GetGUID())
-        visibleFlag |= UF_FLAG_OWNER;
-
-    if (HasDynamicFlag(UNIT_DYNFLAG_SPECIALINFO))
-        if (HasAuraTypeWithCaster(SPELL_AURA_EMPATHY, target->GetGUID()))
-            visibleFlag |= UF_FLAG_SPECIAL_INFO;
-
-    if (plr && plr->IsInSameRaidWith(target))
-        visibleFlag |= UF_FLAG_PARTY_MEMBER;
-    //npcbot
-    else if (IsNPCBotOrPet() && IsInRaidWith(target))
-        visibleFlag |= UF_FLAG_PARTY_MEMBER;
-    //end npcbot
-
-    Creature const* creature = ToCreature();
     for (uint16 index = 0; index < m_valuesCount; ++index)
     {
         if (_fieldNotifyFlags & flags[index] ||
@@ -14406,21 +14388,8 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player const* t
         {
             updateMask.SetBit(index);
 
-            if (index == UNIT_NPC_FLAGS)
-            {
-                uint32 appendValue = m_uint32Values[UNIT_NPC_FLAGS];
-
-                if (creature)
-                    if (!target->CanSeeSpellClickOn(creature))
-                        appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
-
-                fieldBuffer << uint32(appendValue);
-            }
-            else if (index == UNIT_FIELD_AURASTATE)
-            {
-                // Check per caster aura states to not enable using a spell in client if specified aura is not by target
-                fieldBuffer << BuildAuraStateUpdateForTarget(target);
-            }
+            if (IsValuesUpdateFieldTargetDependent(index))
+                fieldBuffer << GetValuesUpdateFieldForTarget(index, target);
             // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
             else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
             {
@@ -14435,121 +14404,143 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player const* t
             {
                 fieldBuffer << uint32(m_floatValues[index]);
             }
-            // Gamemasters should be always able to interact with units - remove uninteractible flag
-            else if (index == UNIT_FIELD_FLAGS)
+            else
             {
-                uint32 appendValue = m_uint32Values[UNIT_FIELD_FLAGS];
-                if (target->IsGameMaster())
-                    appendValue &= ~UNIT_FLAG_UNINTERACTIBLE;
-
-                fieldBuffer << uint32(appendValue);
+                // send in current format (float as float, uint32 as uint32)
+                fieldBuffer << m_uint32Values[index];
             }
-            // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
-            else if (index == UNIT_FIELD_DISPLAYID)
+        }
+    }
+
+    updateMask.AppendToPacket(data);
+    data->append(fieldBuffer);
+}
+
+bool Unit::IsValuesUpdateFieldTargetDependent(uint16 index) const
+{
+    switch (index)
+    {
+        case UNIT_NPC_FLAGS:
+        case UNIT_FIELD_AURASTATE:
+        case UNIT_FIELD_FLAGS:
+        case UNIT_FIELD_DISPLAYID:
+        case UNIT_DYNAMIC_FLAGS:
+        case UNIT_FIELD_BYTES_2:
+        case UNIT_FIELD_FACTIONTEMPLATE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+uint32 Unit::GetValuesUpdateFieldForTarget(uint16 index, Player const* target) const
+{
+    Creature const* creature = ToCreature();
+    switch (index)
+    {
+        case UNIT_NPC_FLAGS:
+        {
+            uint32 appendValue = m_uint32Values[UNIT_NPC_FLAGS];
+
+            if (creature)
+                if (!target->CanSeeSpellClickOn(creature))
+                    appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
+
+            return appendValue;
+        }
+        case UNIT_FIELD_AURASTATE:
+            // Check per caster aura states to not enable using a spell in client if specified aura is not by target
+            return BuildAuraStateUpdateForTarget(target);
+        // Gamemasters should be always able to interact with units - remove uninteractible flag
+        case UNIT_FIELD_FLAGS:
+        {
+            uint32 appendValue = m_uint32Values[UNIT_FIELD_FLAGS];
+            if (target->IsGameMaster())
+                appendValue &= ~UNIT_FLAG_UNINTERACTIBLE;
+
+            return appendValue;
+        }
+        // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
+        case UNIT_FIELD_DISPLAYID:
+        {
+            uint32 displayId = m_uint32Values[UNIT_FIELD_DISPLAYID];
+            if (creature)
             {
-                uint32 displayId = m_uint32Values[UNIT_FIELD_DISPLAYID];
-                if (creature)
-                {
-                    CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
+                CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
 
-                    // this also applies for transform auras
-                    if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(GetTransformSpell()))
+                // this also applies for transform auras
+                if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(GetTransformSpell()))
+                {
+                    for (SpellEffectInfo const& spellEffectInfo : transform->GetEffects())
                     {
-                        for (SpellEffectInfo const& spellEffectInfo : transform->GetEffects())
+                        if (spellEffectInfo.IsAura(SPELL_AURA_TRANSFORM))
                         {
-                            if (spellEffectInfo.IsAura(SPELL_AURA_TRANSFORM))
+                            if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(spellEffectInfo.MiscValue))
                             {
-                                if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(spellEffectInfo.MiscValue))
-                                {
-                                    cinfo = transformInfo;
-                                    break;
-                                }
+                                cinfo = transformInfo;
+                                break;
                             }
                         }
                     }
-
-                    if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
-                        if (target->IsGameMaster())
-                            displayId = cinfo->GetFirstVisibleModel();
                 }
 
-                fieldBuffer << uint32(displayId);
+                if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
+                    if (target->IsGameMaster())
+                        displayId = cinfo->GetFirstVisibleModel();
             }
-            // hide lootable animation for unallowed players
-            else if (index == UNIT_DYNAMIC_FLAGS)
-            {
-                uint32 dynamicFlags = m_uint32Values[UNIT_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
-
-                if (creature)
-                {
-                    if (creature->hasLootRecipient())
-                    {
-                        dynamicFlags |= UNIT_DYNFLAG_TAPPED;
-                        if (creature->isTappedBy(target))
-                            dynamicFlags |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
-                    }
-
-                    if (!target->isAllowedToLoot(creature))
-                        dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
-                }
 
-                // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
-                if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
-                    if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
-                        dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
+            return displayId;
+        }
+        // hide lootable animation for unallowed players
+        case UNIT_DYNAMIC_FLAGS:
+        {
+            uint32 dynamicFlags = m_uint32Values[UNIT_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
 
-                fieldBuffer << dynamicFlags;
-            }
-            // FG: pretend that OTHER players in own group are friendly ("blue")
-            else if (index == UNIT_FIELD_BYTES_2 || index == UNIT_FIELD_FACTIONTEMPLATE)
+            if (creature)
             {
-                if (IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target))
+                if (creature->hasLootRecipient())
                 {
-                    FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
-                    FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
-                    if (!ft1->IsFriendlyTo(*ft2))
-                    {
-                        if (index == UNIT_FIELD_BYTES_2)
-                            // Allow targetting opposite faction in party when enabled in config
-                            fieldBuffer << (m_uint32Values[UNIT_FIELD_BYTES_2] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8)); // this flag is at uint8 offset 1 !!
-                        else
-                            // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
-                            fieldBuffer << uint32(target->GetFaction());
-                    }
-                    else
-                        fieldBuffer << m_uint32Values[index];
-                }
-                //npcbot
-                else if (IsNPCBotOrPet() && IsInRaidWith(target))
-                {
-                    FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
-                    FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
-                    if (!ft1->IsFriendlyTo(*ft2))
-                    {
-                        if (index == UNIT_FIELD_BYTES_2)
-                            // Allow targetting opposite faction in party when enabled in config
-                            fieldBuffer << (m_uint32Values[UNIT_FIELD_BYTES_2] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8)); // this flag is at uint8 offset 1 !!
-                        else
-                            // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
-                            fieldBuffer << uint32(target->GetFaction());
-                    }
-                    else
-                        fieldBuffer << m_uint32Values[index];
+                    dynamicFlags |= UNIT_DYNFLAG_TAPPED;
+                    if (creature->isTappedBy(target))
+                        dynamicFlags |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
                 }
-                //end npcbot
-                else
-                    fieldBuffer << m_uint32Values[index];
+
+                if (!target->isAllowedToLoot(creature))
+                    dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
             }
-            else
+
+            // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
+            if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
+                if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
+                    dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
+
+            return dynamicFlags;
+        }
+        // FG: pretend that OTHER players in own group are friendly ("blue")
+        case UNIT_FIELD_BYTES_2:
+        case UNIT_FIELD_FACTIONTEMPLATE:
+        {
+            bool pretendFriendly = IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target);
+            //npcbot
+            if (!pretendFriendly)
+                pretendFriendly = IsNPCBotOrPet() && IsInRaidWith(target);
+            //end npcbot
+
+            if (pretendFriendly && !GetFactionTemplateEntry()->IsFriendlyTo(*target->GetFactionTemplateEntry()))
             {
-                // send in current format (float as float, uint32 as uint32)
-                fieldBuffer << m_uint32Values[index];
+                if (index == UNIT_FIELD_BYTES_2)
+                    // Allow targetting opposite faction in party when enabled in config
+                    return m_uint32Values[UNIT_FIELD_BYTES_2] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8); // this flag is at uint8 offset 1 !!
+                else
+                    // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
+                    return target->GetFaction();
             }
+
+            return m_uint32Values[index];
         }
+        default:
+            return m_uint32Values[index];
     }
-
-    updateMask.AppendToPacket(data);
-    data->append(fieldBuffer);
 }
 
 int32 Unit::GetHighestExclusiveSameEffectSpellGroupValue(AuraEffect const* aurEff, AuraType auraType, bool checkMiscValue /*= false*/, int32 miscValue /*= 0*/) const
@@ -1844,6 +1844,8 @@ class TC_GAME_API Unit : public WorldObject
         explicit Unit (bool isWorldObject);
 
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player const* target) const override;
+        bool IsValuesUpdateFieldTargetDependent(uint16 index) const override;
+        uint32 GetValuesUpdateFieldForTarget(uint16 index, Player const* target) const override;
 
         void _UpdateSpells(uint32 time);
         void _DeleteRemovedAuras();
@@ -22,6 +22,7 @@
 #include "TypeContainerVisitor.h"
 
 #include "GridDefines.h"
+#include <vector>
 
 class Map;
 class WorldObject;
@@ -108,6 +109,10 @@ struct Cell
     template<class T> static void VisitWorldObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load = true);
     template<class T> static void VisitAllObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load = true);
 
+    // Collects candidates of mapTypeMask in phaseMask around (x, y) from the packed per-cell indexes, without loading grids.
+    // Only a distance prefilter (see CellObjectIndex::Search), callers must still run their exact checks on the result
+    static void SearchObjects(float x, float y, Map* map, float radius, uint32 mapTypeMask, uint32 phaseMask, std::vector<WorldObject*>& result);
+
 private:
     template<class T, class CONTAINER> void VisitCircle(TypeContainerVisitor<T, CONTAINER> &, Map &, CellCoord const&, CellCoord const&) const;
 };
@@ -18,6 +18,7 @@
 #ifndef TRINITY_CELLIMPL_H
 #define TRINITY_CELLIMPL_H
 
+#include <algorithm>
 #include <cmath>
 
 #include "Cell.h"
@@ -240,4 +241,24 @@ inline void Cell::VisitAllObjects(float x, float y, Map* map, T& visitor, float
     cell.Visit(p, gnotifier, *map, x, y, radius);
 }
 
+inline void Cell::SearchObjects(float x, float y, Map* map, float radius, uint32 mapTypeMask, uint32 phaseMask, std::vector<WorldObject*>& result)
+{
+    CellCoord p(Trinity::ComputeCellCoord(x, y));
+    if (!p.IsCoordValid())
+        return;
+
+    if (radius > SIZE_OF_GRIDS)
+        radius = SIZE_OF_GRIDS;
+
+    CellArea area = Cell::CalculateCellArea(x, y, std::max(radius, 0.0f));
+    for (uint32 cell_x = area.low_bound.x_coord; cell_x <= area.high_bound.x_coord; ++cell_x)
+    {
+        for (uint32 cell_y = area.low_bound.y_coord; cell_y <= area.high_bound.y_coord; ++cell_y)
+        {
+            if (CellObjectIndex const* index = map->GetCellObjectIndex(Cell(CellCoord(cell_x, cell_y))))
+                index->Search(x, y, radius, mapTypeMask, phaseMask, result);
+        }
+    }
+}
+
 #endif
@@ -0,0 +1,79 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CellObjectIndex.h"
+#include "GridDefines.h"
+#include "Object.h"
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    // filter in fixed-size blocks so the distance/mask pass stays branch-free and vectorizable
+    constexpr std::size_t SEARCH_BLOCK_SIZE = 64;
+}
+
+void CellObjectIndex::Clear()
+{
+    _x.clear();
+    _y.clear();
+    _reach.clear();
+    _mapTypeMask.clear();
+    _phaseMask.clear();
+    _objects.clear();
+}
+
+void CellObjectIndex::Add(WorldObject* obj, uint32 mapTypeMask)
+{
+    _x.push_back(obj->GetPositionX());
+    _y.push_back(obj->GetPositionY());
+    // gameobject checks use model bounds, never cull them by distance here
+    _reach.push_back(mapTypeMask == GRID_MAP_TYPE_MASK_GAMEOBJECT ? std::numeric_limits<float>::infinity() : obj->GetCombatReach());
+    _mapTypeMask.push_back(mapTypeMask);
+    _phaseMask.push_back(obj->GetPhaseMask());
+    _objects.push_back(obj);
+}
+
+void CellObjectIndex::Search(float x, float y, float radius, uint32 mapTypeMask, uint32 phaseMask, std::vector<WorldObject*>& result) const
+{
+    float const* xs = _x.data();
+    float const* ys = _y.data();
+    float const* reaches = _reach.data();
+    uint32 const* typeMasks = _mapTypeMask.data();
+    uint32 const* phaseMasks = _phaseMask.data();
+
+    uint8 passed[SEARCH_BLOCK_SIZE];
+    std::size_t const count = _objects.size();
+    for (std::size_t begin = 0; begin < count; begin += SEARCH_BLOCK_SIZE)
+    {
+        std::size_t const size = std::min(SEARCH_BLOCK_SIZE, count - begin);
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            float const dx = xs[begin + i] - x;
+            float const dy = ys[begin + i] - y;
+            float const maxDist = radius + reaches[begin + i];
+            passed[i] = uint8(dx * dx + dy * dy <= maxDist * maxDist)
+                & uint8((typeMasks[begin + i] & mapTypeMask) != 0)
+                & uint8((phaseMasks[begin + i] & phaseMask) != 0);
+        }
+
+        for (std::size_t i = 0; i < size; ++i)
+            if (passed[i])
+                result.push_back(_objects[begin + i]);
+    }
+}
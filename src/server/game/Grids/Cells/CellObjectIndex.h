@@ -0,0 +1,60 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef TRINITY_CELLOBJECTINDEX_H
+#define TRINITY_CELLOBJECTINDEX_H
+
+#include "Define.h"
+#include <vector>
+
+class WorldObject;
+
+/*
+  @class CellObjectIndex
+  Packed copy of the positions, map type masks and phase masks of all objects
+  in one grid cell. Radius queries filter the flat arrays first (plain loops the
+  compiler vectorizes) and only touch the objects that passed, instead of walking
+  the cell's linked lists and dereferencing every object.
+  Owned by the cell and rebuilt lazily by Map::GetCellObjectIndex().
+*/
+class TC_GAME_API CellObjectIndex
+{
+    public:
+        void Clear();
+        void Add(WorldObject* obj, uint32 mapTypeMask);
+
+        // Appends objects of mapTypeMask sharing a phase with phaseMask whose 2d distance to (x, y)
+        // is within radius plus their combat reach. Gameobjects always pass the distance test since
+        // their model bounds are unknown here. Result is a superset, callers still do exact checks
+        void Search(float x, float y, float radius, uint32 mapTypeMask, uint32 phaseMask, std::vector<WorldObject*>& result) const;
+
+        bool IsStale(uint32 version, uint32 tick) const { return _dirty || _version != version || _tick != tick; }
+        void SetBuilt(uint32 version, uint32 tick) { _version = version; _tick = tick; _dirty = false; }
+        void Invalidate() { _dirty = true; }
+
+    private:
+        std::vector<float> _x;
+        std::vector<float> _y;
+        std::vector<float> _reach;
+        std::vector<uint32> _mapTypeMask;
+        std::vector<uint32> _phaseMask;
+        std::vector<WorldObject*> _objects;
+
+        uint32 _version = 0;
+        uint32 _tick = 0;
+        bool _dirty = true;
+};
+#endif
@@ -94,6 +94,9 @@ public:
     template<class SPECIFIC_TYPE>
     size_t Count() const;
 
+    /// sum of per-type change counters, differs whenever an object entered or left the container
+    uint32 GetVersion() const;
+
     /// inserts a specific object into the container
     template<class SPECIFIC_TYPE>
     bool insert(SPECIFIC_TYPE *obj);
@@ -126,6 +129,12 @@ size_t TypeMapContainer<OBJECT_TYPES>::Count() const
     return Trinity::Count(i_elements, (SPECIFIC_TYPE*)nullptr);
 }
 
+template <class OBJECT_TYPES>
+uint32 TypeMapContainer<OBJECT_TYPES>::GetVersion() const
+{
+    return Trinity::Version(i_elements);
+}
+
 template <class OBJECT_TYPES>
 template <class SPECIFIC_TYPE>
 bool TypeMapContainer<OBJECT_TYPES>::insert(SPECIFIC_TYPE* obj)
@@ -124,6 +124,16 @@ namespace Trinity
             return Count(elements._TailElements, fake);
     }
 
+    // version functions
+    template<class H, class T>
+    inline uint32 Version(ContainerMapList<TypeList<H, T>> const& elements)
+    {
+        if constexpr (std::is_same_v<T, TypeNull>)
+            return elements._elements._element.getVersion();
+        else
+            return elements._elements._element.getVersion() + Version(elements._TailElements);
+    }
+
     // non-const insert functions
     template<class SPECIFIC_TYPE, class H, class T>
     inline SPECIFIC_TYPE* Insert(ContainerMapList<TypeList<H, T>>& elements, SPECIFIC_TYPE* obj)
@@ -29,6 +29,7 @@
   Grid's perspective, the loader meets its API requirement is suffice.
 */
 
+#include "CellObjectIndex.h"
 #include "Define.h"
 #include "TypeContainer.h"
 #include "TypeContainerVisitor.h"
@@ -106,6 +107,17 @@ class Grid
             return i_objects.template Count<T>();
         }
 
+        /** Changes whenever any object enters or leaves the grid.
+         */
+        uint32 GetVersion() const
+        {
+            return i_container.GetVersion() + i_objects.GetVersion();
+        }
+
+        /** Packed positions of the objects within the grid, maintained by the map.
+         */
+        CellObjectIndex& GetObjectIndex() { return i_objectIndex; }
+
         /** Inserts a container type object into the grid.
          */
         template<class SPECIFIC_OBJECT> void AddGridObject(SPECIFIC_OBJECT *obj)
@@ -136,6 +148,7 @@ class Grid
 
         TypeMapContainer<GRID_OBJECT_TYPES> i_container;
         TypeMapContainer<WORLD_OBJECT_TYPES> i_objects;
+        CellObjectIndex i_objectIndex;
         //typedef std::set<void*> ActiveGridObjects;
         //ActiveGridObjects m_activeGridObjects;
 };
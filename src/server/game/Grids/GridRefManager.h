@@ -34,5 +34,12 @@ class GridRefManager : public RefManager<GridRefManager<OBJECT>, OBJECT>
 
         iterator begin() { return iterator(getFirst()); }
         iterator end() { return iterator(nullptr); }
+
+        // bumped on every link/unlink, lets cached per-cell data detect membership changes
+        uint32 getVersion() const { return _version; }
+        void incVersion() { ++_version; }
+
+    private:
+        uint32 _version = 0;
 };
 #endif
@@ -32,16 +32,22 @@ class GridReference : public Reference<GridRefManager<OBJECT>, OBJECT>
             // called from link()
             this->getTarget()->insertFirst(this);
             this->getTarget()->incSize();
+            this->getTarget()->incVersion();
         }
         void targetObjectDestroyLink() override
         {
             // called from unlink()
-            if (this->isValid()) this->getTarget()->decSize();
+            if (this->isValid())
+            {
+                this->getTarget()->decSize();
+                this->getTarget()->incVersion();
+            }
         }
         void sourceObjectDestroyLink() override
         {
             // called from invalidate()
             this->getTarget()->decSize();
+            this->getTarget()->incVersion();
         }
     public:
         GridReference() : Reference<GridRefManager<OBJECT>, OBJECT>() { }
@@ -127,6 +127,7 @@ namespace Trinity
     {
         WorldObject const* i_source;
         WorldPacket const* i_message;
+        std::shared_ptr<WorldPacket const> i_sharedMessage; // copied once on first delivery, shared by all receivers
         uint32 i_phaseMask;
         float i_distSq;
         uint32 team;
@@ -157,7 +158,10 @@ namespace Trinity
             if (!player->HaveAtClient(i_source))
                 return;
 
-            player->SendDirectMessage(i_message);
+            if (!i_sharedMessage)
+                i_sharedMessage = std::make_shared<WorldPacket const>(*i_message);
+
+            player->SendDirectMessage(i_sharedMessage);
         }
     };
 
@@ -165,6 +169,7 @@ namespace Trinity
     {
         Unit* i_source;
         WorldPacket const* i_message;
+        std::shared_ptr<WorldPacket const> i_sharedMessage; // copied once on first delivery, shared by all receivers
         uint32 i_phaseMask;
         float i_distSq;
 
@@ -184,7 +189,10 @@ namespace Trinity
             if (player == i_source || !player->HaveAtClient(i_source) || player->IsFriendlyTo(i_source))
                 return;
 
-            player->SendDirectMessage(i_message);
+            if (!i_sharedMessage)
+                i_sharedMessage = std::make_shared<WorldPacket const>(*i_message);
+
+            player->SendDirectMessage(i_sharedMessage);
         }
     };
 
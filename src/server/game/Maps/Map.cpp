@@ -16,6 +16,7 @@
  */
 
 #include "Map.h"
+#include "AsyncPathRequest.h"
 #include "Battleground.h"
 #include "CellImpl.h"
 #include "Chat.h"
@@ -281,7 +282,7 @@ m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsUpdateIter(_transports.end()),
 i_gridExpiry(expiry),
-i_scriptLock(false), _respawnTimes(std::make_unique<RespawnListContainer>()), _respawnCheckTimer(0)
+i_scriptLock(false), _pathRequests(std::make_unique<PathRequestQueue>()), _respawnTimes(std::make_unique<RespawnListContainer>()), _respawnCheckTimer(0), _lastUpdateCost(0)
 {
     m_parentMap = (_parent ? _parent : this);
     for (unsigned int idx=0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
@@ -749,6 +750,56 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::Obj
     }
 }
 
+struct CellObjectIndexBuilder
+{
+    CellObjectIndex& i_index;
+    explicit CellObjectIndexBuilder(CellObjectIndex& index) : i_index(index) { }
+
+    template<class T> void Visit(GridRefManager<T>& m)
+    {
+        for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
+            i_index.Add(iter->GetSource(), Trinity::GridMapTypeMaskForType<T>::value);
+    }
+};
+
+CellObjectIndex const* Map::GetCellObjectIndex(Cell const& cell)
+{
+    NGridType* grid = getNGrid(cell.GridX(), cell.GridY());
+    if (!grid || !grid->isGridObjectDataLoaded())
+        return nullptr;
+
+    GridType& cellGrid = grid->GetGridType(cell.CellX(), cell.CellY());
+    CellObjectIndex& index = cellGrid.GetObjectIndex();
+
+    // membership changes are tracked by the cell containers, same-cell moves by relocation functions;
+    // anything that repositions objects bypassing those is caught by the per-tick rebuild
+    uint32 const version = cellGrid.GetVersion();
+    uint32 const tick = GameTime::GetGameTimeMS();
+    if (index.IsStale(version, tick))
+    {
+        index.Clear();
+        CellObjectIndexBuilder builder(index);
+        TypeContainerVisitor<CellObjectIndexBuilder, WorldTypeMapContainer> worldVisitor(builder);
+        cellGrid.Visit(worldVisitor);
+        TypeContainerVisitor<CellObjectIndexBuilder, GridTypeMapContainer> gridVisitor(builder);
+        cellGrid.Visit(gridVisitor);
+        index.SetBuilt(version, tick);
+    }
+
+    return &index;
+}
+
+void Map::InvalidateCellObjectIndex(Cell const& cell)
+{
+    if (NGridType* grid = getNGrid(cell.GridX(), cell.GridY()))
+        grid->GetGridType(cell.CellX(), cell.CellY()).GetObjectIndex().Invalidate();
+}
+
+void Map::QueuePathRequest(std::shared_ptr<AsyncPathRequest> const& request)
+{
+    _pathRequests->Add(request);
+}
+
 void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
 {
     // Nothing to do if no change
@@ -878,6 +929,9 @@ void Map::Update(uint32 t_diff)
         obj->Update(t_diff);
     }
 
+    // nothing moves nor gets loaded until scripts run, paths can be calculated in parallel
+    _pathRequests->Process(this);
+
     SendObjectUpdates();
 
     ///- Process necessary scripts
@@ -1105,6 +1159,8 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
 
         AddToGrid(player, new_cell);
     }
+    else
+        InvalidateCellObjectIndex(old_cell);
 
     player->UpdatePositionData();
     player->UpdateObjectVisibility(false);
@@ -1132,6 +1188,7 @@ void Map::CreatureRelocation(Creature* creature, float x, float y, float z, floa
     else
     {
         creature->Relocate(x, y, z, ang);
+        InvalidateCellObjectIndex(old_cell);
         if (creature->IsVehicle())
             creature->GetVehicleKit()->RelocatePassengers();
         creature->UpdateObjectVisibility(false);
@@ -1165,6 +1222,7 @@ void Map::GameObjectRelocation(GameObject* go, float x, float y, float z, float
     else
     {
         go->Relocate(x, y, z, orientation);
+        InvalidateCellObjectIndex(old_cell);
         go->UpdateModelPosition();
         go->UpdatePositionData();
         go->UpdateObjectVisibility(false);
@@ -1199,6 +1257,7 @@ void Map::DynamicObjectRelocation(DynamicObject* dynObj, float x, float y, float
     else
     {
         dynObj->Relocate(x, y, z, orientation);
+        InvalidateCellObjectIndex(old_cell);
         dynObj->UpdatePositionData();
         dynObj->UpdateObjectVisibility(false);
         RemoveDynamicObjectFromMoveList(dynObj);
@@ -3012,6 +3071,13 @@ inline void Map::setNGrid(NGridType *grid, uint32 x, uint32 y)
 
 void Map::SendObjectUpdates()
 {
+    uint32 sliceCount = sWorld->getIntConfig(CONFIG_MAP_UPDATE_CONTINENT_SLICES);
+    if (sliceCount > 1 && _updateObjects.size() > sliceCount && i_mapEntry->IsContinent() && sMapMgr->GetMapUpdater()->activated())
+    {
+        SendObjectUpdatesSliced(sliceCount);
+        return;
+    }
+
     UpdateDataMapType update_players;
 
     while (!_updateObjects.empty())
@@ -3032,6 +3098,65 @@ void Map::SendObjectUpdates()
     }
 }
 
+void Map::SendObjectUpdatesSliced(uint32 sliceCount)
+{
+    // Building values blocks only reads object and observer state, so slices of the changed objects
+    // are processed concurrently into separate maps, then merged per player before serialization.
+    std::vector<Object*> objects;
+    objects.reserve(_updateObjects.size());
+    for (Object* obj : _updateObjects)
+    {
+        ASSERT(obj->IsInWorld());
+        objects.push_back(obj);
+    }
+    _updateObjects.clear();
+
+    size_t const sliceSize = (objects.size() + sliceCount - 1) / sliceCount;
+    sliceCount = uint32((objects.size() + sliceSize - 1) / sliceSize);
+
+    MapUpdater* updater = sMapMgr->GetMapUpdater();
+
+    std::vector<UpdateDataMapType> sliceUpdates(sliceCount);
+    updater->parallel_for(sliceCount, [&](size_t slice)
+    {
+        size_t end = std::min(objects.size(), (slice + 1) * sliceSize);
+        for (size_t i = slice * sliceSize; i < end; ++i)
+            objects[i]->BuildUpdate(sliceUpdates[slice]);
+    });
+
+    // merge phase, an observer may see objects of several slices
+    UpdateDataMapType update_players = std::move(sliceUpdates[0]);
+    for (uint32 slice = 1; slice < sliceCount; ++slice)
+    {
+        for (UpdateDataMapType::value_type& sliceUpdate : sliceUpdates[slice])
+        {
+            auto itr = update_players.try_emplace(sliceUpdate.first, std::move(sliceUpdate.second));
+            if (!itr.second)
+                itr.first->second.Append(std::move(sliceUpdate.second));
+        }
+    }
+
+    std::vector<UpdateDataMapType::value_type*> receivers;
+    receivers.reserve(update_players.size());
+    for (UpdateDataMapType::value_type& update : update_players)
+        receivers.push_back(&update);
+
+    // packet building includes compression, split it between the same number of workers
+    size_t const batchSize = (receivers.size() + sliceCount - 1) / sliceCount;
+    size_t const batchCount = batchSize ? (receivers.size() + batchSize - 1) / batchSize : 0;
+    updater->parallel_for(batchCount, [&](size_t batch)
+    {
+        WorldPacket packet;
+        size_t end = std::min(receivers.size(), (batch + 1) * batchSize);
+        for (size_t i = batch * batchSize; i < end; ++i)
+        {
+            receivers[i]->second.BuildPacket(&packet);
+            receivers[i]->first->SendDirectMessage(&packet);
+            packet.clear();
+        }
+    });
+}
+
 // CheckRespawn MUST do one of the following:
 //  -) return true
 //  -) set info->respawnTime to zero, which indicates the respawn time should be deleted (and will never be processed again without outside intervention)
@@ -3689,8 +3814,13 @@ uint32 Map::GetPlayersCountExceptGMs() const
 
 void Map::SendToPlayers(WorldPacket const* data) const
 {
+    if (m_mapRefManager.isEmpty())
+        return;
+
+    // one payload copy shared by all sessions
+    std::shared_ptr<WorldPacket const> sharedData = std::make_shared<WorldPacket const>(*data);
     for (MapRefManager::const_iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
-        itr->GetSource()->SendDirectMessage(data);
+        itr->GetSource()->SendDirectMessage(sharedData);
 }
 
 /// Send a packet to all players (or players selected team) in the zone (except self if mentioned)
@@ -39,6 +39,7 @@
 #include <memory>
 #include <mutex>
 
+class AsyncPathRequest;
 class Battleground;
 class BattlegroundMap;
 class CreatureGroup;
@@ -48,6 +49,7 @@ class InstanceMap;
 class InstanceSave;
 class InstanceScript;
 class MapInstanced;
+class PathRequestQueue;
 class Object;
 class Player;
 class TempSummon;
@@ -325,6 +327,14 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         template<class T, class CONTAINER>
         void Visit(Cell const& cell, TypeContainerVisitor<T, CONTAINER>& visitor);
 
+        // Packed object index of a loaded cell, nullptr otherwise. Rebuilt on access when objects entered, left
+        // or moved inside the cell, or a new tick started. Map thread only, not from parallel object update stages
+        CellObjectIndex const* GetCellObjectIndex(Cell const& cell);
+        void InvalidateCellObjectIndex(Cell const& cell);
+
+        // Path is calculated later in this or the next update, poll the request for the result
+        void QueuePathRequest(std::shared_ptr<AsyncPathRequest> const& request);
+
         bool IsRemovalGrid(float x, float y) const
         {
             GridCoord p = Trinity::ComputeGridCoord(x, y);
@@ -392,6 +402,11 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         uint32 GetInstanceId() const { return i_InstanceId; }
         uint8 GetSpawnMode() const { return (i_spawnMode); }
 
+        // duration of the previous Update() in microseconds, MapUpdater schedules expensive maps first
+        uint32 GetLastUpdateCost() const { return _lastUpdateCost; }
+        void SetLastUpdateCost(uint32 cost) { _lastUpdateCost = cost; }
+        virtual uint32 GetUpdateCostEstimate() const { return _lastUpdateCost; }
+
         Trinity::unique_weak_ptr<Map> GetWeakPtr() const { return m_weakRef; }
         void SetWeakPtr(Trinity::unique_weak_ptr<Map> weakRef) { m_weakRef = std::move(weakRef); }
 
@@ -668,6 +683,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void ScriptsProcess();
 
         void SendObjectUpdates();
+        void SendObjectUpdatesSliced(uint32 sliceCount);
 
     protected:
         void SetUnloadReferenceLock(GridCoord const& p, bool on) { getNGrid(p.x_coord, p.y_coord)->setUnloadReferenceLock(on); }
@@ -814,6 +830,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
                 m_activeNonPlayers.erase(obj);
         }
 
+        std::unique_ptr<PathRequestQueue> _pathRequests;
+
         std::unique_ptr<RespawnListContainer> _respawnTimes;
         RespawnInfoMap       _creatureRespawnTimesBySpawnId;
         RespawnInfoMap       _gameObjectRespawnTimesBySpawnId;
@@ -846,6 +864,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         std::unordered_set<uint32> _toggledSpawnGroupIds;
 
         uint32 _respawnCheckTimer;
+        uint32 _lastUpdateCost;
         std::unordered_map<uint32, uint32> _zonePlayerCountMap;
 
         ZoneDynamicInfoMap _zoneDynamicInfo;
@@ -29,6 +29,7 @@
 #include "VMapFactory.h"
 #include "VMapManager2.h"
 #include "World.h"
+#include <algorithm>
 
 MapInstanced::MapInstanced(uint32 id, time_t expiry) : Map(id, expiry, 0, DUNGEON_DIFFICULTY_NORMAL)
 {
@@ -55,6 +56,7 @@ void MapInstanced::Update(uint32 t)
     // update the instanced maps
     InstancedMaps::iterator i = m_InstancedMaps.begin();
 
+    std::vector<Map*> scheduled;
     while (i != m_InstancedMaps.end())
     {
         if (i->second->CanUnload(t))
@@ -68,12 +70,30 @@ void MapInstanced::Update(uint32 t)
         {
             // update only here, because it may schedule some bad things before delete
             if (sMapMgr->GetMapUpdater()->activated())
-                sMapMgr->GetMapUpdater()->schedule_update(*i->second, t);
+                scheduled.push_back(i->second.get());
             else
                 i->second->Update(t);
             ++i;
         }
     }
+
+    // longest previous tick first so the slowest instance does not start last
+    std::stable_sort(scheduled.begin(), scheduled.end(), [](Map const* left, Map const* right)
+    {
+        return left->GetUpdateCostEstimate() > right->GetUpdateCostEstimate();
+    });
+
+    for (Map* map : scheduled)
+        sMapMgr->GetMapUpdater()->schedule_update(*map, t);
+}
+
+uint32 MapInstanced::GetUpdateCostEstimate() const
+{
+    uint32 cost = Map::GetUpdateCostEstimate();
+    for (InstancedMaps::value_type const& instance : m_InstancedMaps)
+        cost = std::max(cost, instance.second->GetUpdateCostEstimate());
+
+    return cost;
 }
 
 void MapInstanced::DelayedUpdate(uint32 diff)
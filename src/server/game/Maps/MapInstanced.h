@@ -35,6 +35,7 @@ class TC_GAME_API MapInstanced : public Map
         // functions overwrite Map versions
         void Update(uint32 diff) override;
         void DelayedUpdate(uint32 diff) override;
+        uint32 GetUpdateCostEstimate() const override;
         //void RelocationNotify();
         void UnloadAll() override;
         EnterState CannotEnter(Player* /*player*/) override;
@@ -34,6 +34,7 @@
 #include "WorldSession.h"
 #include "Opcodes.h"
 #include "ScriptMgr.h"
+#include <algorithm>
 #include <numeric>
 
 //npcbot
@@ -235,15 +236,29 @@ void MapManager::Update(uint32 diff)
         return;
 
     MapMapType::iterator iter = i_maps.begin();
-    for (; iter != i_maps.end(); ++iter)
+    if (m_updater.activated())
     {
-        if (m_updater.activated())
-            m_updater.schedule_update(*iter->second, uint32(i_timer.GetCurrent()));
-        else
+        // longest previous tick first, a busy continent starting last would stretch the whole world tick
+        std::vector<Map*> maps;
+        maps.reserve(i_maps.size());
+        for (; iter != i_maps.end(); ++iter)
+            maps.push_back(iter->second.get());
+
+        std::stable_sort(maps.begin(), maps.end(), [](Map const* left, Map const* right)
+        {
+            return left->GetUpdateCostEstimate() > right->GetUpdateCostEstimate();
+        });
+
+        for (Map* map : maps)
+            m_updater.schedule_update(*map, uint32(i_timer.GetCurrent()));
+
+        m_updater.wait();
+    }
+    else
+    {
+        for (; iter != i_maps.end(); ++iter)
             iter->second->Update(uint32(i_timer.GetCurrent()));
     }
-    if (m_updater.activated())
-        m_updater.wait();
 
     //npcbot
     BotMgr::HandleDelayedTeleports();
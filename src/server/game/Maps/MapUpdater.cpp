@@ -20,36 +20,63 @@
 #include "Map.h"
 #include "Metric.h"
 
+#include <algorithm>
+#include <chrono>
+#include <memory>
 #include <mutex>
 
-class MapUpdateRequest
+namespace
 {
-    private:
+    // index of the worker queue owned by the current thread, tasks scheduled from workers stay local
+    thread_local MapUpdater const* t_workerOwner = nullptr;
+    thread_local size_t t_workerIndex = 0;
+}
 
-        Map& m_map;
-        MapUpdater& m_updater;
-        uint32 m_diff;
+struct MapParallelForState
+{
+    MapParallelForState(size_t count, std::function<void(size_t)> const& func) : Count(count), Func(func), Next(0), Done(0) { }
 
-    public:
+    // Processes one index, returns false when every index was already claimed
+    bool RunNext()
+    {
+        size_t index = Next++;
+        if (index >= Count)
+            return false;
 
-        MapUpdateRequest(Map& m, MapUpdater& u, uint32 d)
-            : m_map(m), m_updater(u), m_diff(d)
-        {
-        }
+        Func(index);
 
-        void call()
+        if (++Done == Count)
         {
-            TC_METRIC_TIMER("map_update_time_diff", TC_METRIC_TAG("map_id", std::to_string(m_map.GetId())));
-            m_map.Update (m_diff);
-            m_updater.update_finished();
+            std::lock_guard<std::mutex> lock(Lock);
+            Condition.notify_all();
         }
+        return true;
+    }
+
+    void WaitDone()
+    {
+        std::unique_lock<std::mutex> lock(Lock);
+        while (Done < Count)
+            Condition.wait(lock);
+    }
+
+    size_t const Count;
+    // only dereferenced after claiming a valid index, caller is blocked in WaitDone() until then
+    std::function<void(size_t)> const& Func;
+    std::atomic<size_t> Next;
+    std::atomic<size_t> Done;
+    std::mutex Lock;
+    std::condition_variable Condition;
 };
 
 void MapUpdater::activate(size_t num_threads)
 {
+    for (size_t i = 0; i < num_threads; ++i)
+        _workerQueues.push_back(std::make_unique<WorkerQueue>());
+
     for (size_t i = 0; i < num_threads; ++i)
     {
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
     }
 }
 
@@ -59,7 +86,10 @@ void MapUpdater::deactivate()
 
     wait();
 
-    _queue.Cancel();
+    {
+        std::lock_guard<std::mutex> lock(_sleepLock);
+        _sleepCondition.notify_all();
+    }
 
     for (auto& thread : _workerThreads)
     {
@@ -79,11 +109,33 @@ void MapUpdater::wait()
 
 void MapUpdater::schedule_update(Map& map, uint32 diff)
 {
-    std::lock_guard<std::mutex> lock(_lock);
-
     ++pending_requests;
 
-    _queue.Push(new MapUpdateRequest(map, *this, diff));
+    Task task;
+    task.UpdateMap = &map;
+    task.Diff = diff;
+    push_task(std::move(task));
+}
+
+void MapUpdater::parallel_for(size_t count, std::function<void(size_t)> const& func)
+{
+    if (!count)
+        return;
+
+    std::shared_ptr<MapParallelForState> state = std::make_shared<MapParallelForState>(count, func);
+
+    // helpers are not counted in pending_requests, a late helper finds nothing left and exits
+    size_t helpers = std::min(count - 1, _workerThreads.size());
+    for (size_t i = 0; i < helpers; ++i)
+    {
+        Task task;
+        task.ParallelFor = state;
+        push_task(std::move(task));
+    }
+
+    while (state->RunNext());
+
+    state->WaitDone();
 }
 
 bool MapUpdater::activated()
@@ -93,30 +145,104 @@ bool MapUpdater::activated()
 
 void MapUpdater::update_finished()
 {
+    if (--pending_requests > 0)
+        return;
+
     std::lock_guard<std::mutex> lock(_lock);
+    _condition.notify_all();
+}
 
-    --pending_requests;
+void MapUpdater::push_task(Task&& task)
+{
+    size_t queueIndex = t_workerOwner == this ? t_workerIndex : _nextQueue++ % _workerQueues.size();
 
-    _condition.notify_all();
+    // counted before it becomes visible so a thief can never bring the counter below zero
+    ++_queuedTasks;
+
+    {
+        WorkerQueue& queue = *_workerQueues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.Lock);
+        queue.Tasks.push_back(std::move(task));
+    }
+
+    // sleeping workers re-check _queuedTasks under this lock, so the wakeup cannot be lost
+    {
+        std::lock_guard<std::mutex> lock(_sleepLock);
+    }
+    _sleepCondition.notify_one();
 }
 
-void MapUpdater::WorkerThread()
+bool MapUpdater::pop_task(size_t workerIndex, Task& task)
+{
+    {
+        WorkerQueue& own = *_workerQueues[workerIndex];
+        std::lock_guard<std::mutex> lock(own.Lock);
+        if (!own.Tasks.empty())
+        {
+            task = std::move(own.Tasks.front());
+            own.Tasks.pop_front();
+            --_queuedTasks;
+            return true;
+        }
+    }
+
+    for (size_t i = 1; i < _workerQueues.size(); ++i)
+    {
+        WorkerQueue& victim = *_workerQueues[(workerIndex + i) % _workerQueues.size()];
+        std::lock_guard<std::mutex> lock(victim.Lock);
+        if (!victim.Tasks.empty())
+        {
+            task = std::move(victim.Tasks.front());
+            victim.Tasks.pop_front();
+            --_queuedTasks;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void MapUpdater::run_task(Task& task)
+{
+    if (task.ParallelFor)
+    {
+        while (task.ParallelFor->RunNext());
+        return;
+    }
+
+    Map& map = *task.UpdateMap;
+    {
+        TC_METRIC_TIMER("map_update_time_diff", TC_METRIC_TAG("map_id", std::to_string(map.GetId())));
+        auto start = std::chrono::steady_clock::now();
+        map.Update(task.Diff);
+        map.SetLastUpdateCost(uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()));
+    }
+    update_finished();
+}
+
+void MapUpdater::WorkerThread(size_t workerIndex)
 {
     LoginDatabase.WarnAboutSyncQueries(true);
     CharacterDatabase.WarnAboutSyncQueries(true);
     WorldDatabase.WarnAboutSyncQueries(true);
 
+    t_workerOwner = this;
+    t_workerIndex = workerIndex;
+
     while (true)
     {
-        MapUpdateRequest* request = nullptr;
+        Task task;
+        if (pop_task(workerIndex, task))
+        {
+            run_task(task);
+            continue;
+        }
 
-        _queue.WaitAndPop(request);
+        std::unique_lock<std::mutex> lock(_sleepLock);
+        while (!_queuedTasks && !_cancelationToken)
+            _sleepCondition.wait(lock);
 
         if (_cancelationToken)
             return;
-
-        request->call();
-
-        delete request;
     }
 }
@@ -19,25 +19,33 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Define.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
-#include <condition_variable>
-#include "ProducerConsumerQueue.h"
+#include <vector>
 
-class MapUpdateRequest;
+struct MapParallelForState;
 class Map;
 
 class TC_GAME_API MapUpdater
 {
     public:
 
-        MapUpdater() : _cancelationToken(false), pending_requests(0) {}
+        MapUpdater() : _cancelationToken(false), _queuedTasks(0), _nextQueue(0), pending_requests(0) {}
         ~MapUpdater() { };
 
-        friend class MapUpdateRequest;
-
+        // Maps scheduled from the world thread are distributed round-robin in the order given,
+        // callers schedule the most expensive maps first (see Map::GetUpdateCostEstimate)
         void schedule_update(Map& map, uint32 diff);
 
+        // Runs func(0) .. func(count - 1) using idle worker threads, calling thread takes part in the work too.
+        // Returns once every index has been processed. Safe to call from inside a map update.
+        void parallel_for(size_t count, std::function<void(size_t)> const& func);
+
         void wait();
 
         void activate(size_t num_threads);
@@ -48,18 +56,42 @@ class TC_GAME_API MapUpdater
 
     private:
 
-        ProducerConsumerQueue<MapUpdateRequest*> _queue;
-
+        // stored by value, scheduling does not allocate per request
+        struct Task
+        {
+            Map* UpdateMap = nullptr;
+            uint32 Diff = 0;
+            std::shared_ptr<MapParallelForState> ParallelFor;
+        };
+
+        // kept in scheduling order (most expensive first), idle workers steal from the front of other queues
+        struct WorkerQueue
+        {
+            std::mutex Lock;
+            std::deque<Task> Tasks;
+        };
+
+        std::vector<std::unique_ptr<WorkerQueue>> _workerQueues;
         std::vector<std::thread> _workerThreads;
         std::atomic<bool> _cancelationToken;
+        std::atomic<size_t> _queuedTasks;
+        std::atomic<size_t> _nextQueue;
+
+        // only used to put idle workers to sleep
+        std::mutex _sleepLock;
+        std::condition_variable _sleepCondition;
 
         std::mutex _lock;
         std::condition_variable _condition;
-        size_t pending_requests;
+        std::atomic<size_t> pending_requests;
+
+        void push_task(Task&& task);
+        bool pop_task(size_t workerIndex, Task& task);
+        void run_task(Task& task);
 
         void update_finished();
 
-        void WorkerThread();
+        void WorkerThread(size_t workerIndex);
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
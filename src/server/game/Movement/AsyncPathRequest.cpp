@@ -0,0 +1,184 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AsyncPathRequest.h"
+#include "Map.h"
+#include "MapManager.h"
+#include "MapUpdater.h"
+#include "MMapFactory.h"
+#include "MMapManager.h"
+#include "Unit.h"
+#include "World.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <unordered_map>
+
+namespace
+{
+    std::atomic<uint32> NextWorkerSlot{ 0 };
+
+    // every thread gets its own navmesh query slot, map threads and map updater workers alike
+    uint32 GetWorkerSlot()
+    {
+        thread_local uint32 const slot = NextWorkerSlot++;
+        return slot;
+    }
+
+    // half yard buckets, 21 bits per axis are enough for any map coord
+    uint64 DestinationKey(G3D::Vector3 const& dest)
+    {
+        auto quantize = [](float v) { return uint64(int64(std::floor(v * 2.0f)) & 0x1FFFFF); };
+        return quantize(dest.x) | (quantize(dest.y) << 21) | (quantize(dest.z) << 42);
+    }
+
+    // paths to farther destinations are calculated on the map thread
+    constexpr uint32 MAX_CORRIDOR_GRIDS = 4;
+
+    // height and liquid lookups done while building a path load missing grids, which is only allowed on the map thread.
+    // Path points are not bound to the straight line between the ends, so every grid of the box around both ends
+    // plus one grid of margin must already be loaded
+    bool IsCorridorLoaded(Map const* map, Unit const* owner, G3D::Vector3 const& dest)
+    {
+        GridCoord const from = Trinity::ComputeGridCoord(owner->GetPositionX(), owner->GetPositionY());
+        GridCoord const to = Trinity::ComputeGridCoord(dest.x, dest.y);
+        uint32 const lowX = std::min(from.x_coord, to.x_coord);
+        uint32 const highX = std::max(from.x_coord, to.x_coord);
+        uint32 const lowY = std::min(from.y_coord, to.y_coord);
+        uint32 const highY = std::max(from.y_coord, to.y_coord);
+        if (highX - lowX > MAX_CORRIDOR_GRIDS || highY - lowY > MAX_CORRIDOR_GRIDS)
+            return false;
+
+        for (uint32 x = lowX ? lowX - 1 : 0; x <= std::min(highX + 1, uint32(MAX_NUMBER_OF_GRIDS) - 1); ++x)
+            for (uint32 y = lowY ? lowY - 1 : 0; y <= std::min(highY + 1, uint32(MAX_NUMBER_OF_GRIDS) - 1); ++y)
+                if (!map->IsGridLoaded(GridCoord(x, y).GetId()))
+                    return false;
+
+        return true;
+    }
+}
+
+AsyncPathRequest::AsyncPathRequest(Unit* owner, float destX, float destY, float destZ, bool forceDest) :
+    _owner(owner), _dest(destX, destY, destZ), _forceDest(forceDest), _path(owner), _result(false), _state(STATE_PENDING)
+{
+}
+
+void AsyncPathRequest::Calculate(dtNavMeshQuery const* query)
+{
+    if (query)
+        _result = _path.CalculatePath(query, _dest.x, _dest.y, _dest.z, _forceDest);
+    else
+        _result = _path.CalculatePath(_dest.x, _dest.y, _dest.z, _forceDest);
+    _state = STATE_DONE;
+}
+
+bool AsyncPathRequest::CanShareWith(AsyncPathRequest const& leader) const
+{
+    if (_forceDest != leader._forceDest || (_dest - leader._dest).squaredLength() > 0.01f)
+        return false;
+
+    Unit const* other = leader._owner;
+    if (_owner->GetExactDistSq(other) > 1.5f * 1.5f)
+        return false;
+
+    // everything the path filter and liquid checks depend on
+    return _owner->GetTypeId() == other->GetTypeId() &&
+        _owner->GetPhaseMask() == other->GetPhaseMask() &&
+        _owner->CanFly() == other->CanFly() &&
+        _owner->CanSwim() == other->CanSwim() &&
+        _owner->IsInWater() == other->IsInWater() &&
+        _owner->IsInCombat() == other->IsInCombat() &&
+        _owner->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING) == other->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING);
+}
+
+void PathRequestQueue::Add(std::shared_ptr<AsyncPathRequest> const& request)
+{
+    if (!sWorld->getBoolConfig(CONFIG_ENABLE_MMAPS_ASYNC))
+    {
+        request->Calculate(nullptr);
+        return;
+    }
+
+    _requests.push_back(request);
+}
+
+void PathRequestQueue::Process(Map* map)
+{
+    if (_requests.empty())
+        return;
+
+    std::vector<std::shared_ptr<AsyncPathRequest>> requests;
+    requests.reserve(_requests.size());
+    for (std::weak_ptr<AsyncPathRequest> const& weakRequest : _requests)
+        if (std::shared_ptr<AsyncPathRequest> request = weakRequest.lock())
+            requests.push_back(std::move(request));
+    _requests.clear();
+
+    std::vector<AsyncPathRequest*> leaders;
+    std::vector<std::pair<AsyncPathRequest*, AsyncPathRequest const*>> followers;
+    std::unordered_map<uint64, std::vector<AsyncPathRequest const*>> leadersByDest;
+    leaders.reserve(requests.size());
+
+    for (std::shared_ptr<AsyncPathRequest> const& request : requests)
+    {
+        if (!request->IsPending())
+            continue;
+
+        Unit const* owner = request->_owner;
+        if (!owner->IsInWorld() || owner->GetMap() != map)
+        {
+            request->_state = AsyncPathRequest::STATE_CANCELLED;
+            continue;
+        }
+
+        if (!IsCorridorLoaded(map, owner, request->_dest))
+        {
+            request->Calculate(nullptr);
+            continue;
+        }
+
+        std::vector<AsyncPathRequest const*>& sameDest = leadersByDest[DestinationKey(request->_dest)];
+        auto leader = std::find_if(sameDest.begin(), sameDest.end(), [&request](AsyncPathRequest const* other) { return request->CanShareWith(*other); });
+        if (leader != sameDest.end())
+            followers.emplace_back(request.get(), *leader);
+        else
+        {
+            sameDest.push_back(request.get());
+            leaders.push_back(request.get());
+        }
+    }
+
+    uint32 const mapId = map->GetId();
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+    sMapMgr->GetMapUpdater()->parallel_for(leaders.size(), [&leaders, mapId, mmap](size_t i)
+    {
+        // without a query of our own the request stays pending and is calculated below
+        if (dtNavMeshQuery const* query = mmap->GetWorkerNavMeshQuery(mapId, GetWorkerSlot()))
+            leaders[i]->Calculate(query);
+    });
+
+    for (AsyncPathRequest* leader : leaders)
+        if (leader->IsPending())
+            leader->Calculate(nullptr);
+
+    for (auto const& [follower, leader] : followers)
+    {
+        follower->_path.CopyPathFrom(leader->_path);
+        follower->_result = leader->_result;
+        follower->_state = AsyncPathRequest::STATE_DONE;
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_ASYNCPATHREQUEST_H
+#define TRINITY_ASYNCPATHREQUEST_H
+
+#include "Define.h"
+#include "PathGenerator.h"
+#include <memory>
+#include <vector>
+
+class Map;
+class Unit;
+
+// Path calculation deferred to the owner's map, see PathRequestQueue.
+// Created, queued, cancelled and consumed on the map thread only.
+class TC_GAME_API AsyncPathRequest
+{
+    friend class PathRequestQueue;
+
+    public:
+        AsyncPathRequest(Unit* owner, float destX, float destY, float destZ, bool forceDest = false);
+
+        AsyncPathRequest(AsyncPathRequest const&) = delete;
+        AsyncPathRequest& operator=(AsyncPathRequest const&) = delete;
+
+        bool IsPending() const { return _state == STATE_PENDING; }
+        bool IsDone() const { return _state == STATE_DONE; }
+        // owner is about to forget the request, it will not be calculated nor touched by the queue anymore
+        void Cancel() { if (_state == STATE_PENDING) _state = STATE_CANCELLED; }
+
+        // result getters, valid once done
+        // same as PathGenerator::CalculatePath() return value
+        bool GetResult() const { return _result; }
+        PathGenerator& GetPath() { return _path; }
+        PathGenerator const& GetPath() const { return _path; }
+
+        G3D::Vector3 const& GetDestination() const { return _dest; }
+
+    private:
+        enum State : uint8
+        {
+            STATE_PENDING,
+            STATE_DONE,
+            STATE_CANCELLED
+        };
+
+        void Calculate(dtNavMeshQuery const* query);
+        bool CanShareWith(AsyncPathRequest const& leader) const;
+
+        Unit* const _owner;
+        G3D::Vector3 const _dest;
+        bool const _forceDest;
+
+        PathGenerator _path;
+        bool _result;
+        State _state;
+};
+
+// Per-map queue of path requests
+// Requests are calculated in parallel once per update at a point where no objects of the map move
+// and no grids get loaded, each worker thread using its own navmesh query.
+// Requests of nearby units heading to the same point are calculated only once.
+// Requests that may touch grids which are not loaded yet are calculated on the map thread.
+class TC_GAME_API PathRequestQueue
+{
+    public:
+        // calculates the request right away if async pathfinding is disabled
+        void Add(std::shared_ptr<AsyncPathRequest> const& request);
+        void Process(Map* map);
+
+        bool IsEmpty() const { return _requests.empty(); }
+
+    private:
+        // the owner keeps the request alive, dropped requests are simply skipped
+        std::vector<std::weak_ptr<AsyncPathRequest>> _requests;
+};
+
+#endif
@@ -16,15 +16,18 @@
  */
 
 #include "ChaseMovementGenerator.h"
+#include "AsyncPathRequest.h"
 #include "Creature.h"
 #include "CreatureAI.h"
 #include "G3DPosition.hpp"
+#include "Map.h"
 #include "MotionMaster.h"
 #include "MoveSpline.h"
 #include "MoveSplineInit.h"
 #include "PathGenerator.h"
 #include "Unit.h"
 #include "Util.h"
+#include "World.h"
 
 static bool HasLostTarget(Unit* owner, Unit* target)
 {
@@ -81,6 +84,7 @@ void ChaseMovementGenerator::Initialize(Unit* /*owner*/)
     AddFlag(MOVEMENTGENERATOR_FLAG_INITIALIZED | MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
 
     _path = nullptr;
+    ResetPathRequest();
     _lastTargetPosition.reset();
 }
 
@@ -105,6 +109,7 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
     // the owner might be unable to move (rooted or casting), or we have lost the target, pause movement
     if (owner->HasUnitState(UNIT_STATE_NOT_MOVE) || owner->IsMovementPreventedByCasting() || HasLostTarget(owner, target))
     {
+        ResetPathRequest();
         owner->StopMoving();
         _lastTargetPosition.reset();
         if (Creature* cOwner = owner->ToCreature())
@@ -129,6 +134,7 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
         {
             RemoveFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
             _path = nullptr;
+            ResetPathRequest();
             if (Creature* cOwner = owner->ToCreature())
                 cOwner->SetCannotReachTarget(false);
             owner->StopMoving();
@@ -150,6 +156,9 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
         DoMovementInform(owner, target);
     }
 
+    // path requested last update is ready
+    LaunchCalculatedPath(owner, target, maxTarget);
+
     // if the target moved, we have to consider whether to adjust
     if (!_lastTargetPosition || target->GetPosition() != _lastTargetPosition.value() || mutualChase != _mutualChase)
     {
@@ -164,6 +173,7 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
                 cOwner->SetCannotReachTarget(true);
                 cOwner->StopMoving();
                 _path = nullptr;
+                ResetPathRequest();
                 return true;
             }
 
@@ -193,54 +203,94 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
             if (owner->IsHovering())
                 owner->UpdateAllowedPositionZ(x, y, z);
 
-            bool success = _path->CalculatePath(x, y, z, owner->CanFly());
-            if (!success || (_path->GetPathType() & (PATHFIND_NOPATH /* | PATHFIND_INCOMPLETE*/)))
+            _shortenPath = shortenPath;
+            if (!sWorld->getBoolConfig(CONFIG_ENABLE_MMAPS_ASYNC))
+                LaunchPath(owner, target, maxTarget, _path->CalculatePath(x, y, z, owner->CanFly()));
+            else
             {
-                if (cOwner)
-                    cOwner->SetCannotReachTarget(true);
-                owner->StopMoving();
-                return true;
+                // a newer request replaces the one still pending
+                ResetPathRequest();
+                _pathRequest = std::make_shared<AsyncPathRequest>(owner, x, y, z, owner->CanFly());
+                // seeded with the current path so its poly corridor is reused, as by the inline calculation
+                _pathRequest->GetPath().CopyPathFrom(*_path);
+                owner->GetMap()->QueuePathRequest(_pathRequest);
             }
+        }
+    }
 
-            if (shortenPath)
-                _path->ShortenPathUntilDist(PositionToVector3(target), maxTarget);
+    // and then, finally, we're done for the tick
+    return true;
+}
 
-            if (cOwner)
-                cOwner->SetCannotReachTarget(false);
+void ChaseMovementGenerator::ResetPathRequest()
+{
+    if (!_pathRequest)
+        return;
 
-            bool walk = false;
-            if (cOwner && !cOwner->IsPet())
-            {
-                switch (cOwner->GetMovementTemplate().GetChase())
-                {
-                    case CreatureChaseMovementType::CanWalk:
-                        walk = owner->IsWalking();
-                        break;
-                    case CreatureChaseMovementType::AlwaysWalk:
-                        walk = true;
-                        break;
-                    default:
-                        break;
-                }
-            }
+    _pathRequest->Cancel();
+    _pathRequest = nullptr;
+}
+
+void ChaseMovementGenerator::LaunchCalculatedPath(Unit* owner, Unit* target, float maxTarget)
+{
+    if (!_pathRequest || !_pathRequest->IsDone())
+        return;
 
-            owner->AddUnitState(UNIT_STATE_CHASE_MOVE);
-            AddFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
+    std::shared_ptr<AsyncPathRequest> request = std::move(_pathRequest);
 
-            Movement::MoveSplineInit init(owner);
-            init.MovebyPath(_path->GetPath());
-            init.SetWalk(walk);
-            init.SetFacing(target);
-            init.Launch();
+    // the result becomes the current path, next request starts from its corridor
+    if (!_path)
+        _path = std::make_unique<PathGenerator>(owner);
+    _path->CopyPathFrom(request->GetPath());
+    LaunchPath(owner, target, maxTarget, request->GetResult());
+}
+
+void ChaseMovementGenerator::LaunchPath(Unit* owner, Unit* target, float maxTarget, bool calculated)
+{
+    Creature* const cOwner = owner->ToCreature();
+    if (!calculated || (_path->GetPathType() & (PATHFIND_NOPATH /* | PATHFIND_INCOMPLETE*/)))
+    {
+        if (cOwner)
+            cOwner->SetCannotReachTarget(true);
+        owner->StopMoving();
+        return;
+    }
+
+    if (_shortenPath)
+        _path->ShortenPathUntilDist(PositionToVector3(target), maxTarget);
+
+    if (cOwner)
+        cOwner->SetCannotReachTarget(false);
+
+    bool walk = false;
+    if (cOwner && !cOwner->IsPet())
+    {
+        switch (cOwner->GetMovementTemplate().GetChase())
+        {
+            case CreatureChaseMovementType::CanWalk:
+                walk = owner->IsWalking();
+                break;
+            case CreatureChaseMovementType::AlwaysWalk:
+                walk = true;
+                break;
+            default:
+                break;
         }
     }
 
-    // and then, finally, we're done for the tick
-    return true;
+    owner->AddUnitState(UNIT_STATE_CHASE_MOVE);
+    AddFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
+
+    Movement::MoveSplineInit init(owner);
+    init.MovebyPath(_path->GetPath());
+    init.SetWalk(walk);
+    init.SetFacing(target);
+    init.Launch();
 }
 
 void ChaseMovementGenerator::Deactivate(Unit* owner)
 {
+    ResetPathRequest();
     AddFlag(MOVEMENTGENERATOR_FLAG_DEACTIVATED);
     RemoveFlag(MOVEMENTGENERATOR_FLAG_TRANSITORY | MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
     owner->ClearUnitState(UNIT_STATE_CHASE_MOVE);
@@ -251,6 +301,7 @@ void ChaseMovementGenerator::Deactivate(Unit* owner)
 void ChaseMovementGenerator::Finalize(Unit* owner, bool active, bool/* movementInform*/)
 {
     AddFlag(MOVEMENTGENERATOR_FLAG_FINALIZED);
+    ResetPathRequest();
     if (active)
     {
         owner->ClearUnitState(UNIT_STATE_CHASE_MOVE);
@@ -25,6 +25,7 @@
 #include "Position.h"
 #include "Timer.h"
 
+class AsyncPathRequest;
 class PathGenerator;
 class Unit;
 
@@ -46,10 +47,16 @@ class ChaseMovementGenerator : public MovementGenerator, public AbstractFollower
     private:
         static constexpr uint32 RANGE_CHECK_INTERVAL = 100; // time (ms) until we attempt to recalculate
 
+        void ResetPathRequest();
+        void LaunchCalculatedPath(Unit* owner, Unit* target, float maxTarget);
+        void LaunchPath(Unit* owner, Unit* target, float maxTarget, bool calculated);
+
         Optional<ChaseRange> const _range;
         Optional<ChaseAngle> const _angle;
 
         std::unique_ptr<PathGenerator> _path;
+        std::shared_ptr<AsyncPathRequest> _pathRequest;
+        bool _shortenPath = false;
         Optional<Position> _lastTargetPosition;
         TimeTracker _rangeCheckTimer;
         bool _movingTowards = true;
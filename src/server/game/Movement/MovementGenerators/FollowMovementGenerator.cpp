@@ -16,8 +16,10 @@
  */
 
 #include "FollowMovementGenerator.h"
+#include "AsyncPathRequest.h"
 #include "Creature.h"
 #include "CreatureAI.h"
+#include "Map.h"
 #include "MoveSpline.h"
 #include "MoveSplineInit.h"
 #include "Optional.h"
@@ -25,6 +27,7 @@
 #include "Pet.h"
 #include "Unit.h"
 #include "Util.h"
+#include "World.h"
 
 static void DoMovementInform(Unit* owner, Unit* target)
 {
@@ -60,6 +63,7 @@ void FollowMovementGenerator::Initialize(Unit* owner)
     owner->StopMoving();
     UpdatePetSpeed(owner);
     _path = nullptr;
+    ResetPathRequest();
     _lastTargetPosition.reset();
 }
 
@@ -84,6 +88,7 @@ bool FollowMovementGenerator::Update(Unit* owner, uint32 diff)
     if (owner->HasUnitState(UNIT_STATE_NOT_MOVE) || owner->IsMovementPreventedByCasting())
     {
         _path = nullptr;
+        ResetPathRequest();
         owner->StopMoving();
         _lastTargetPosition.reset();
         return true;
@@ -97,6 +102,7 @@ bool FollowMovementGenerator::Update(Unit* owner, uint32 diff)
         {
             RemoveFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
             _path = nullptr;
+            ResetPathRequest();
             owner->StopMoving();
             _lastTargetPosition.reset();
             DoMovementInform(owner, target);
@@ -112,6 +118,9 @@ bool FollowMovementGenerator::Update(Unit* owner, uint32 diff)
         DoMovementInform(owner, target);
     }
 
+    // path requested last update is ready
+    LaunchCalculatedPath(owner, target);
+
     if (!_lastTargetPosition || _lastTargetPosition->GetExactDistSq(target->GetPosition()) > 0.0f)
     {
         _lastTargetPosition = target->GetPosition();
@@ -150,21 +159,17 @@ bool FollowMovementGenerator::Update(Unit* owner, uint32 diff)
                     allowShortcut = true;
             }
 
-            bool success = _path->CalculatePath(x, y, z, allowShortcut);
-            if (!success || (_path->GetPathType() & PATHFIND_NOPATH))
+            if (!sWorld->getBoolConfig(CONFIG_ENABLE_MMAPS_ASYNC))
+                LaunchPath(owner, target, _path->CalculatePath(x, y, z, allowShortcut));
+            else
             {
-                owner->StopMoving();
-                return true;
+                // a newer request replaces the one still pending
+                ResetPathRequest();
+                _pathRequest = std::make_shared<AsyncPathRequest>(owner, x, y, z, allowShortcut);
+                // seeded with the current path so its poly corridor is reused, as by the inline calculation
+                _pathRequest->GetPath().CopyPathFrom(*_path);
+                owner->GetMap()->QueuePathRequest(_pathRequest);
             }
-
-            owner->AddUnitState(UNIT_STATE_FOLLOW_MOVE);
-            AddFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
-
-            Movement::MoveSplineInit init(owner);
-            init.MovebyPath(_path->GetPath());
-            init.SetWalk(target->IsWalking());
-            init.SetFacing(target->GetOrientation());
-            init.Launch();
         }
     }
     return true;
@@ -172,6 +177,7 @@ bool FollowMovementGenerator::Update(Unit* owner, uint32 diff)
 
 void FollowMovementGenerator::Deactivate(Unit* owner)
 {
+    ResetPathRequest();
     AddFlag(MOVEMENTGENERATOR_FLAG_DEACTIVATED);
     RemoveFlag(MOVEMENTGENERATOR_FLAG_TRANSITORY | MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
     owner->ClearUnitState(UNIT_STATE_FOLLOW_MOVE);
@@ -180,6 +186,7 @@ void FollowMovementGenerator::Deactivate(Unit* owner)
 void FollowMovementGenerator::Finalize(Unit* owner, bool active, bool/* movementInform*/)
 {
     AddFlag(MOVEMENTGENERATOR_FLAG_FINALIZED);
+    ResetPathRequest();
     if (active)
     {
         owner->ClearUnitState(UNIT_STATE_FOLLOW_MOVE);
@@ -187,6 +194,47 @@ void FollowMovementGenerator::Finalize(Unit* owner, bool active, bool/* movement
     }
 }
 
+void FollowMovementGenerator::ResetPathRequest()
+{
+    if (!_pathRequest)
+        return;
+
+    _pathRequest->Cancel();
+    _pathRequest = nullptr;
+}
+
+void FollowMovementGenerator::LaunchCalculatedPath(Unit* owner, Unit* target)
+{
+    if (!_pathRequest || !_pathRequest->IsDone())
+        return;
+
+    std::shared_ptr<AsyncPathRequest> request = std::move(_pathRequest);
+
+    // the result becomes the current path, next request starts from its corridor
+    if (!_path)
+        _path = std::make_unique<PathGenerator>(owner);
+    _path->CopyPathFrom(request->GetPath());
+    LaunchPath(owner, target, request->GetResult());
+}
+
+void FollowMovementGenerator::LaunchPath(Unit* owner, Unit* target, bool calculated)
+{
+    if (!calculated || (_path->GetPathType() & PATHFIND_NOPATH))
+    {
+        owner->StopMoving();
+        return;
+    }
+
+    owner->AddUnitState(UNIT_STATE_FOLLOW_MOVE);
+    AddFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
+
+    Movement::MoveSplineInit init(owner);
+    init.MovebyPath(_path->GetPath());
+    init.SetWalk(target->IsWalking());
+    init.SetFacing(target->GetOrientation());
+    init.Launch();
+}
+
 void FollowMovementGenerator::UpdatePetSpeed(Unit* owner)
 {
     if (Pet* oPet = owner->ToPet())
@@ -25,6 +25,7 @@
 #include "Position.h"
 #include "Timer.h"
 
+class AsyncPathRequest;
 class PathGenerator;
 class Unit;
 
@@ -49,12 +50,16 @@ class FollowMovementGenerator : public MovementGenerator, public AbstractFollowe
         static constexpr uint32 CHECK_INTERVAL = 100;
 
         void UpdatePetSpeed(Unit* owner);
+        void ResetPathRequest();
+        void LaunchCalculatedPath(Unit* owner, Unit* target);
+        void LaunchPath(Unit* owner, Unit* target, bool calculated);
 
         float const _range;
         ChaseAngle const _angle;
 
-        TimeTracker _checkTimer;
         std::unique_ptr<PathGenerator> _path;
+        TimeTracker _checkTimer;
+        std::shared_ptr<AsyncPathRequest> _pathRequest;
         Optional<Position> _lastTargetPosition;
 };
 
@@ -90,6 +90,36 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
     return true;
 }
 
+bool PathGenerator::CalculatePath(dtNavMeshQuery const* query, float destX, float destY, float destZ, bool forceDest)
+{
+    // no mmaps for this object, nothing to swap
+    if (!_navMeshQuery)
+        return CalculatePath(destX, destY, destZ, forceDest);
+
+    dtNavMeshQuery const* ownQuery = _navMeshQuery;
+    _navMeshQuery = query;
+    bool result = CalculatePath(destX, destY, destZ, forceDest);
+    _navMeshQuery = ownQuery;
+    return result;
+}
+
+void PathGenerator::CopyPathFrom(PathGenerator const& other)
+{
+    memcpy(_pathPolyRefs, other._pathPolyRefs, sizeof(dtPolyRef) * other._polyLength);
+    _polyLength = other._polyLength;
+    _pathPoints = other._pathPoints;
+    _type = other._type;
+    _forceDestination = other._forceDestination;
+    _endPosition = other._endPosition;
+    _actualEndPosition = other._actualEndPosition;
+
+    float x, y, z;
+    _source->GetPosition(x, y, z);
+    SetStartPosition(G3D::Vector3(x, y, z));
+    if (!_pathPoints.empty())
+        _pathPoints[0] = _startPosition;
+}
+
 dtPolyRef PathGenerator::GetPathPolyByPosition(dtPolyRef const* polyPath, uint32 polyPathSize, float const* point, float* distance) const
 {
     if (!polyPath || !polyPathSize)
@@ -62,6 +62,10 @@ class TC_GAME_API PathGenerator
         // Calculate the path from owner to given destination
         // return: true if new path was calculated, false otherwise (no change needed)
         bool CalculatePath(float destX, float destY, float destZ, bool forceDest = false);
+        // same as above but uses given query instead of the instance one, for calculations off the map thread
+        bool CalculatePath(dtNavMeshQuery const* query, float destX, float destY, float destZ, bool forceDest = false);
+        // take over a path calculated for another object standing close to ours
+        void CopyPathFrom(PathGenerator const& other);
         bool IsInvalidDestinationZ(Unit const* target) const;
 
         // option setters - use optional
@@ -22,6 +22,7 @@
 #include "Opcodes.h"
 #include "ByteBuffer.h"
 #include "Duration.h"
+#include <atomic>
 
 class WorldPacket : public ByteBuffer
 {
@@ -62,6 +63,7 @@ class WorldPacket : public ByteBuffer
             if (this != &right)
             {
                 m_opcode = right.m_opcode;
+                m_receivedTime = right.m_receivedTime;
                 ByteBuffer::operator=(std::move(right));
             }
 
@@ -81,6 +83,9 @@ class WorldPacket : public ByteBuffer
         void SetOpcode(uint16 opcode) { m_opcode = opcode; }
 
         TimePoint GetReceivedTime() const { return m_receivedTime; }
+        void SetReceivedTime(TimePoint receivedTime) { m_receivedTime = receivedTime; }
+
+        std::atomic<WorldPacket*> QueueLink; // intrusive link for WorldSession receive queue and packet pool
 
     protected:
         uint16 m_opcode;
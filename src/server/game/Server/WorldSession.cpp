@@ -56,6 +56,7 @@
 #include "WorldPacket.h"
 #include "WorldSocket.h"
 #include <boost/circular_buffer.hpp>
+#include <bit>
 #include <zlib.h>
 
 //npcbot
@@ -66,6 +67,22 @@ namespace {
 
 std::string const DefaultPlayerName = "<none>";
 
+// Processed packets kept per session for the network thread to refill, client packets are always smaller than 10 KB
+constexpr uint32 MAX_RECV_PACKET_POOL_SIZE = 32;
+
+// Heartbeats are only coalesced once the session falls this many packets behind, a session keeping up handles each of them
+constexpr std::size_t RECV_BACKLOG_COALESCE_THRESHOLD = 50;
+
+bool IsSameMover(WorldPacket const& left, WorldPacket const& right)
+{
+    if (left.empty() || right.empty())
+        return false;
+
+    // movement packets start with the mover's packed guid
+    std::size_t guidSize = 1 + std::popcount(left[0]);
+    return left.size() >= guidSize && right.size() >= guidSize && std::memcmp(left.contents(), right.contents(), guidSize) == 0;
+}
+
 } // namespace
 
 bool MapSessionFilter::Process(WorldPacket* packet)
@@ -137,6 +154,7 @@ WorldSession::WorldSession(uint32 id, std::string&& name, std::shared_ptr<WorldS
     m_TutorialsChanged(TUTORIALS_FLAG_NONE),
     recruiterId(recruiter),
     isRecruiter(isARecruiter),
+    _recvPacketPoolSize(0),
     _RBACData(nullptr),
     expireTime(60000), // 1 min after socket loss, session is deleted
     forceExit(false),
@@ -178,9 +196,8 @@ WorldSession::~WorldSession()
 
     delete _gameClient;
 
-    ///- empty incoming packet queue
-    WorldPacket* packet = nullptr;
-    while (_recvQueue.next(packet))
+    ///- empty incoming packet buffer, queue and pool empty themselves
+    for (WorldPacket* packet : _recvBuffer)
         delete packet;
 
     LoginDatabase.PExecute("UPDATE account SET online = 0 WHERE id = {};", GetAccountId());     // One-time query
@@ -211,11 +228,26 @@ ObjectGuid::LowType WorldSession::GetGUIDLow() const
 /// Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const* packet)
 {
-    ASSERT(packet->GetOpcode() != NULL_OPCODE);
+    if (!m_Socket)
+        return;
+
+    LogSendPacket(*packet);
+    m_Socket->SendPacket(*packet);
+}
 
+void WorldSession::SendPacket(std::shared_ptr<WorldPacket const> const& packet)
+{
     if (!m_Socket)
         return;
 
+    LogSendPacket(*packet);
+    m_Socket->SendPacket(packet);
+}
+
+void WorldSession::LogSendPacket(WorldPacket const& packet)
+{
+    ASSERT(packet.GetOpcode() != NULL_OPCODE);
+
 #ifdef TRINITY_DEBUG
     // Code for network use statistic
     static uint64 sendPacketCount = 0;
@@ -232,10 +264,10 @@ void WorldSession::SendPacket(WorldPacket const* packet)
     if ((cur_time - lastTime) < 60)
     {
         sendPacketCount += 1;
-        sendPacketBytes += packet->size();
+        sendPacketBytes += packet.size();
 
         sendLastPacketCount += 1;
-        sendLastPacketBytes += packet->size();
+        sendLastPacketBytes += packet.size();
     }
     else
     {
@@ -246,20 +278,67 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 
         lastTime = cur_time;
         sendLastPacketCount = 1;
-        sendLastPacketBytes = packet->wpos();               // wpos is real written size
+        sendLastPacketBytes = packet.wpos();                // wpos is real written size
     }
 #endif                                                      // !TRINITY_DEBUG
 
-    sScriptMgr->OnPacketSend(this, *packet);
+    sScriptMgr->OnPacketSend(this, packet);
 
-    TC_LOG_TRACE("network.opcode", "S->C: {} {}", GetPlayerInfo(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())));
-    m_Socket->SendPacket(*packet);
+    TC_LOG_TRACE("network.opcode", "S->C: {} {}", GetPlayerInfo(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet.GetOpcode())));
 }
 
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
-    _recvQueue.add(new_packet);
+    _recvQueue.Enqueue(new_packet);
+}
+
+WorldPacket* WorldSession::AcquireRecvPacket()
+{
+    WorldPacket* packet = nullptr;
+    if (_recvPacketPool.Dequeue(packet))
+    {
+        --_recvPacketPoolSize;
+        return packet;
+    }
+
+    return new WorldPacket();
+}
+
+void WorldSession::RecycleRecvPacket(WorldPacket* packet)
+{
+    if (_recvPacketPoolSize >= MAX_RECV_PACKET_POOL_SIZE)
+    {
+        delete packet;
+        return;
+    }
+
+    ++_recvPacketPoolSize;
+    _recvPacketPool.Enqueue(packet);
+}
+
+/// Take the next packet the filter allows, keeping only the newest of consecutive heartbeats from the same mover while backlogged
+bool WorldSession::NextRecvPacket(WorldPacket*& packet, PacketFilter& updater)
+{
+    if (_recvBuffer.empty() || !updater.Process(_recvBuffer.front()))
+        return false;
+
+    packet = _recvBuffer.front();
+    _recvBuffer.pop_front();
+
+    // heartbeats carry complete movement state, older ones would only be overwritten
+    while (packet->GetOpcode() == MSG_MOVE_HEARTBEAT && _recvBuffer.size() >= RECV_BACKLOG_COALESCE_THRESHOLD)
+    {
+        WorldPacket* next = _recvBuffer.front();
+        if (next->GetOpcode() != MSG_MOVE_HEARTBEAT || !IsSameMover(*packet, *next))
+            break;
+
+        RecycleRecvPacket(packet);
+        packet = next;
+        _recvBuffer.pop_front();
+    }
+
+    return true;
 }
 
 /// Logging helper for unexpected opcodes
@@ -292,6 +371,9 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     ///- Retrieve packets from the receive queue and call the appropriate handlers
     /// not process packets if socket already closed
     WorldPacket* packet = nullptr;
+    while (_recvQueue.Dequeue(packet))
+        _recvBuffer.push_back(packet);
+
     //! Delete packet after processing by default
     bool deletePacket = true;
     std::vector<WorldPacket*> requeuePackets;
@@ -300,7 +382,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
     constexpr uint32 MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE = 100;
 
-    while (m_Socket && _recvQueue.next(packet, updater))
+    while (m_Socket && NextRecvPacket(packet, updater))
     {
         OpcodeClient opcode = static_cast<OpcodeClient>(packet->GetOpcode());
         ClientOpcodeHandler const* opHandle = opcodeTable[opcode];
@@ -426,7 +508,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
         }
 
         if (deletePacket)
-            delete packet;
+            RecycleRecvPacket(packet);
 
         deletePacket = true;
 
@@ -440,7 +522,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
     TC_METRIC_VALUE("processed_packets", processedPackets);
 
-    _recvQueue.readd(requeuePackets.begin(), requeuePackets.end());
+    _recvBuffer.insert(_recvBuffer.begin(), requeuePackets.begin(), requeuePackets.end());
 
     if (!updater.ProcessUnsafe()) // <=> updater is of type MapSessionFilter
     {
@@ -27,11 +27,12 @@
 #include "AuthDefines.h"
 #include "DatabaseEnvFwd.h"
 #include "Duration.h"
-#include "LockedQueue.h"
+#include "MPSCQueue.h"
 #include "ObjectGuid.h"
 #include "Packet.h"
 #include "SharedDefines.h"
 #include <boost/circular_buffer_fwd.hpp>
+#include <deque>
 #include <string>
 #include <map>
 #include <memory>
@@ -454,6 +455,8 @@ class TC_GAME_API WorldSession
         void static WriteMovementInfo(WorldPacket* data, MovementInfo* mi);
 
         void SendPacket(WorldPacket const* packet);
+        // same packet sent to many sessions, payload is not copied per session
+        void SendPacket(std::shared_ptr<WorldPacket const> const& packet);
         void SendNotification(const char *format, ...) ATTR_PRINTF(2, 3);
         void SendNotification(uint32 string_id, ...);
         void SendPetNameInvalid(uint32 error, std::string const& name, DeclinedName *declinedName);
@@ -521,6 +524,8 @@ class TC_GAME_API WorldSession
         bool DisallowHyperlinksAndMaybeKick(std::string const& str);
 
         void QueuePacket(WorldPacket* new_packet);
+        /// Returns a processed packet for reuse by the network thread (called under WorldSocket::_worldSessionLock)
+        WorldPacket* AcquireRecvPacket();
         bool Update(uint32 diff, PacketFilter& updater);
 
         /// Handle the authentication waiting queue (to be completed)
@@ -1215,6 +1220,10 @@ class TC_GAME_API WorldSession
         void LogUnexpectedOpcode(WorldPacket* packet, char const* status, const char *reason);
         void LogUnprocessedTail(WorldPacket* packet);
 
+        bool NextRecvPacket(WorldPacket*& packet, PacketFilter& updater);
+        void RecycleRecvPacket(WorldPacket* packet);
+        void LogSendPacket(WorldPacket const& packet);
+
         // EnumData helpers
         bool IsLegitCharacterForAccount(ObjectGuid lowGUID)
         {
@@ -1281,7 +1290,10 @@ class TC_GAME_API WorldSession
         } _addons;
         uint32 recruiterId;
         bool isRecruiter;
-        LockedQueue<WorldPacket*> _recvQueue;
+        MPSCQueue<WorldPacket, &WorldPacket::QueueLink> _recvQueue;
+        std::deque<WorldPacket*> _recvBuffer;               // packets taken from _recvQueue, only touched by the thread updating the session
+        MPSCQueue<WorldPacket, &WorldPacket::QueueLink> _recvPacketPool;
+        std::atomic<uint32> _recvPacketPoolSize;
         rbac::RBACData* _RBACData;
         uint32 expireTime;
         bool forceExit;
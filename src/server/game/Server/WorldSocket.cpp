@@ -88,28 +88,29 @@ bool WorldSocket::Update()
         MessageBuffer buffer(_sendBufferSize);
         do
         {
-            ServerPktHeader header(queued->size() + 2, queued->GetOpcode());
+            WorldPacket const& packet = queued->GetPacket();
+            ServerPktHeader header(packet.size() + 2, packet.GetOpcode());
             if (queued->NeedsEncryption())
                 _authCrypt.EncryptSend(header.header, header.getHeaderLength());
 
-            if (buffer.GetRemainingSpace() < queued->size() + header.getHeaderLength())
+            if (buffer.GetRemainingSpace() < packet.size() + header.getHeaderLength())
             {
                 QueuePacket(std::move(buffer));
                 buffer.Resize(_sendBufferSize);
             }
 
-            if (buffer.GetRemainingSpace() >= queued->size() + header.getHeaderLength())
+            if (buffer.GetRemainingSpace() >= packet.size() + header.getHeaderLength())
             {
                 buffer.Write(header.header, header.getHeaderLength());
-                if (!queued->empty())
-                    buffer.Write(queued->contents(), queued->size());
+                if (!packet.empty())
+                    buffer.Write(packet.contents(), packet.size());
             }
             else    // single packet larger than buffer size
             {
-                MessageBuffer packetBuffer(queued->size() + header.getHeaderLength());
+                MessageBuffer packetBuffer(packet.size() + header.getHeaderLength());
                 packetBuffer.Write(header.header, header.getHeaderLength());
-                if (!queued->empty())
-                    packetBuffer.Write(queued->contents(), queued->size());
+                if (!packet.empty())
+                    packetBuffer.Write(packet.contents(), packet.size());
 
                 QueuePacket(std::move(packetBuffer));
             }
@@ -305,7 +306,6 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
     OpcodeClient opcode = static_cast<OpcodeClient>(header->cmd);
 
     WorldPacket packet(opcode, std::move(_packetBuffer));
-    WorldPacket* packetToQueue;
 
     if (sPacketLog->CanLogPacket())
         sPacketLog->LogPacket(packet, CLIENT_TO_SERVER, GetRemoteIpAddress(), GetRemotePort());
@@ -360,11 +360,10 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
             TC_LOG_ERROR("network", "WorldSocket::ReadDataHandler: client {} sent CMSG_KEEP_ALIVE without being authenticated", GetRemoteIpAddress().to_string());
             return ReadDataHandlerResult::Error;
         case CMSG_TIME_SYNC_RESP:
-            packetToQueue = new WorldPacket(std::move(packet), std::chrono::steady_clock::now());
+            packet.SetReceivedTime(std::chrono::steady_clock::now());
             break;
 
         default:
-            packetToQueue = new WorldPacket(std::move(packet));
             break;
     }
 
@@ -375,7 +374,6 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
     if (!_worldSession)
     {
         TC_LOG_ERROR("network.opcode", "ProcessIncoming: Client not authed opcode = {}", uint32(opcode));
-        delete packetToQueue;
         return ReadDataHandlerResult::Error;
     }
 
@@ -383,14 +381,16 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
     if (!handler)
     {
         TC_LOG_ERROR("network.opcode", "No defined handler for opcode {} sent by {}", GetOpcodeNameForLogging(static_cast<OpcodeClient>(packet.GetOpcode())), _worldSession->GetPlayerInfo());
-        delete packetToQueue;
         return ReadDataHandlerResult::Error;
     }
 
     // Our Idle timer will reset on any non PING opcodes on login screen, allowing us to catch people idling.
     _worldSession->ResetTimeOutTime(false);
 
-    // Copy the packet to the heap before enqueuing
+    // Move the packet into one the session already processed, its old storage becomes our next read buffer
+    WorldPacket* packetToQueue = _worldSession->AcquireRecvPacket();
+    _packetBuffer = MessageBuffer(packetToQueue->Move());
+    *packetToQueue = std::move(packet);
     _worldSession->QueuePacket(packetToQueue);
 
     return ReadDataHandlerResult::Ok;
@@ -426,6 +426,17 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
     _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt.IsInitialized()));
 }
 
+void WorldSocket::SendPacket(std::shared_ptr<WorldPacket const> const& packet)
+{
+    if (!IsOpen())
+        return;
+
+    if (sPacketLog->CanLogPacket())
+        sPacketLog->LogPacket(*packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
+
+    _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt.IsInitialized()));
+}
+
 void WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
 {
     std::shared_ptr<AuthSession> authSession = std::make_shared<AuthSession>();
@@ -37,11 +37,19 @@ public:
         SocketQueueLink.store(nullptr, std::memory_order_relaxed);
     }
 
+    // payload of a broadcast packet, shared by every socket it is sent to, only the header is built per socket
+    EncryptablePacket(std::shared_ptr<WorldPacket const> packet, bool encrypt) : _sharedPacket(std::move(packet)), _encrypt(encrypt)
+    {
+        SocketQueueLink.store(nullptr, std::memory_order_relaxed);
+    }
+
+    WorldPacket const& GetPacket() const { return _sharedPacket ? *_sharedPacket : *this; }
     bool NeedsEncryption() const { return _encrypt; }
 
     std::atomic<EncryptablePacket*> SocketQueueLink;
 
 private:
+    std::shared_ptr<WorldPacket const> _sharedPacket;
     bool _encrypt;
 };
 
@@ -79,6 +87,7 @@ public:
     bool Update() override;
 
     void SendPacket(WorldPacket const& packet);
+    void SendPacket(std::shared_ptr<WorldPacket const> const& packet);
 
     void SetSendBufferSize(std::size_t sendBufferSize) { _sendBufferSize = sendBufferSize; }
 
@@ -34,6 +34,7 @@ public:
     void SocketAdded(std::shared_ptr<WorldSocket> sock) override
     {
         sock->SetSendBufferSize(sWorldSocketMgr.GetApplicationSendBufferSize());
+        sock->SetWriteGatherLimits(sWorldSocketMgr.GetWriteGatherMaxBuffers(), sWorldSocketMgr.GetWriteGatherMaxBytes());
         sScriptMgr->OnSocketOpen(sock);
     }
 
@@ -43,7 +44,8 @@ public:
     }
 };
 
-WorldSocketMgr::WorldSocketMgr() : BaseSocketMgr(), _socketSystemSendBufferSize(-1), _socketApplicationSendBufferSize(65536), _tcpNoDelay(true)
+WorldSocketMgr::WorldSocketMgr() : BaseSocketMgr(), _socketSystemSendBufferSize(-1), _socketApplicationSendBufferSize(65536),
+    _writeGatherMaxBuffers(WRITE_GATHER_MAX_BUFFERS), _writeGatherMaxBytes(WRITE_GATHER_MAX_BYTES), _tcpNoDelay(true)
 {
 }
 
@@ -56,6 +58,8 @@ WorldSocketMgr& WorldSocketMgr::Instance()
 bool WorldSocketMgr::StartWorldNetwork(Trinity::Asio::IoContext& ioContext, std::string const& bindIp, uint16 port, int threadCount)
 {
     _tcpNoDelay = sConfigMgr->GetBoolDefault("Network.TcpNodelay", true);
+    _acceptorPerThread = sConfigMgr->GetBoolDefault("Network.ReusePort", false);
+    _threadAffinity = sConfigMgr->GetBoolDefault("Network.ThreadAffinity", false);
 
     int const max_connections = TRINITY_MAX_LISTEN_CONNECTIONS;
     TC_LOG_DEBUG("misc", "Max allowed socket connections {}", max_connections);
@@ -71,10 +75,21 @@ bool WorldSocketMgr::StartWorldNetwork(Trinity::Asio::IoContext& ioContext, std:
         return false;
     }
 
+    int32 writeGatherMaxBuffers = sConfigMgr->GetIntDefault("Network.WriteGather.MaxBuffers", WRITE_GATHER_MAX_BUFFERS);
+    int32 writeGatherMaxBytes = sConfigMgr->GetIntDefault("Network.WriteGather.MaxBytes", WRITE_GATHER_MAX_BYTES);
+    if (writeGatherMaxBuffers <= 0 || writeGatherMaxBytes < 0)
+    {
+        TC_LOG_ERROR("misc", "Network.WriteGather.MaxBuffers or Network.WriteGather.MaxBytes is wrong in your config file");
+        return false;
+    }
+
+    _writeGatherMaxBuffers = writeGatherMaxBuffers;
+    _writeGatherMaxBytes = writeGatherMaxBytes;
+
     if (!BaseSocketMgr::StartNetwork(ioContext, bindIp, port, threadCount))
         return false;
 
-    _acceptor->AsyncAcceptWithCallback<&OnSocketAccept>();
+    AsyncAcceptWithCallback<&OnSocketAccept>();
 
     sScriptMgr->OnNetworkStart();
     return true;
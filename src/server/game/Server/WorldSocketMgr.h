@@ -45,6 +45,8 @@ public:
     void OnSocketOpen(tcp::socket&& sock, uint32 threadIndex) override;
 
     std::size_t GetApplicationSendBufferSize() const { return _socketApplicationSendBufferSize; }
+    std::size_t GetWriteGatherMaxBuffers() const { return _writeGatherMaxBuffers; }
+    std::size_t GetWriteGatherMaxBytes() const { return _writeGatherMaxBytes; }
 
 protected:
     WorldSocketMgr();
@@ -54,6 +56,8 @@ protected:
 private:
     int32 _socketSystemSendBufferSize;
     int32 _socketApplicationSendBufferSize;
+    std::size_t _writeGatherMaxBuffers;
+    std::size_t _writeGatherMaxBytes;
     bool _tcpNoDelay;
 };
 
@@ -1242,8 +1242,7 @@ void Spell::SelectImplicitConeTargets(SpellEffectInfo const& spellEffectInfo, Sp
     {
         float extraSearchRadius = radius > 0.0f ? EXTRA_CELL_SEARCH_RADIUS : 0.0f;
         Trinity::WorldObjectSpellConeTargetCheck check(coneAngle, radius, m_caster, m_spellInfo, selectionType, condList);
-        Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellConeTargetCheck> searcher(m_caster, targets, check, containerTypeMask);
-        SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellConeTargetCheck> >(searcher, containerTypeMask, m_caster, m_caster, radius + extraSearchRadius);
+        SearchTargetList(targets, check, containerTypeMask, m_caster->GetPhaseMask(), m_caster, m_caster, radius + extraSearchRadius);
 
         CallScriptObjectAreaTargetSelectHandlers(targets, spellEffectInfo.EffectIndex, targetType);
 
@@ -1931,6 +1930,20 @@ void Spell::SearchTargets(SEARCHER& searcher, uint32 containerMask, WorldObject*
     }
 }
 
+template<class CHECK>
+void Spell::SearchTargetList(std::list<WorldObject*>& targets, CHECK& check, uint32 containerMask, uint32 phaseMask, WorldObject* referer, Position const* pos, float radius)
+{
+    if (!containerMask)
+        return;
+
+    // prefilter on the packed cell indexes, exact checks only for objects in radius
+    std::vector<WorldObject*> candidates;
+    Cell::SearchObjects(pos->GetPositionX(), pos->GetPositionY(), referer->GetMap(), radius, containerMask, phaseMask, candidates);
+    for (WorldObject* candidate : candidates)
+        if (check(candidate))
+            targets.push_back(candidate);
+}
+
 WorldObject* Spell::SearchNearbyTarget(float range, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionContainer* condList)
 {
     WorldObject* target = nullptr;
@@ -1953,9 +1966,7 @@ void Spell::SearchAreaTargets(std::list<WorldObject*>& targets, float range, Pos
 
     float extraSearchRadius = range > 0.0f ? EXTRA_CELL_SEARCH_RADIUS : 0.0f;
     Trinity::WorldObjectSpellAreaTargetCheck check(range, position, m_caster, referer, m_spellInfo, selectionType, condList);
-    Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> searcher(m_caster, targets, check, containerTypeMask);
-    searcher.i_phaseMask = PHASEMASK_ANYWHERE;
-    SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellAreaTargetCheck>>(searcher, containerTypeMask, m_caster, position, range + extraSearchRadius);
+    SearchTargetList(targets, check, containerTypeMask, PHASEMASK_ANYWHERE, m_caster, position, range + extraSearchRadius);
 }
 
 void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectType, ConditionContainer* condList, bool isChainHeal)
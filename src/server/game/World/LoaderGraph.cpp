@@ -0,0 +1,162 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LoaderGraph.h"
+#include "Errors.h"
+#include "Log.h"
+#include "StringFormat.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+
+LoaderGraph::LoaderId LoaderGraph::Add(std::string name, std::function<void()> loader, std::initializer_list<LoaderId> dependencies)
+{
+    LoaderId id = _loaders.size();
+    for (LoaderId dependency : dependencies)
+    {
+        ASSERT(dependency < id, "Loader %s must be added after its dependencies", name.c_str());
+        _loaders[dependency].Dependents.push_back(id);
+    }
+
+    Loader& entry = _loaders.emplace_back();
+    entry.Name = std::move(name);
+    entry.Function = std::move(loader);
+    entry.Dependencies = dependencies;
+    return id;
+}
+
+void LoaderGraph::Run(std::size_t threadCount)
+{
+    _threadCount = std::max<std::size_t>(std::min(threadCount, _loaders.size()), 1);
+
+    TimePoint graphStart = std::chrono::steady_clock::now();
+
+    if (_threadCount == 1)
+    {
+        for (LoaderId id = 0; id < _loaders.size(); ++id)
+            RunLoader(id, graphStart);
+    }
+    else
+    {
+        std::vector<std::size_t> pendingDependencies(_loaders.size());
+        for (LoaderId id = 0; id < _loaders.size(); ++id)
+            pendingDependencies[id] = _loaders[id].Dependencies.size();
+
+        std::mutex lock;
+        std::condition_variable allFinished;
+        std::size_t remaining = _loaders.size();
+
+        Trinity::ThreadPool pool(_threadCount);
+        std::function<void(LoaderId)> schedule = [&](LoaderId id)
+        {
+            pool.PostWork([&, id]()
+            {
+                RunLoader(id, graphStart);
+
+                std::vector<LoaderId> ready;
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    for (LoaderId dependent : _loaders[id].Dependents)
+                        if (!--pendingDependencies[dependent])
+                            ready.push_back(dependent);
+
+                    if (!--remaining)
+                        allFinished.notify_one();
+                }
+
+                for (LoaderId dependent : ready)
+                    schedule(dependent);
+            });
+        };
+
+        for (LoaderId id = 0; id < _loaders.size(); ++id)
+            if (_loaders[id].Dependencies.empty())
+                schedule(id);
+
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            allFinished.wait(guard, [&remaining]() { return remaining == 0; });
+        }
+
+        pool.Join();
+    }
+
+    _totalDuration = std::chrono::duration_cast<Milliseconds>(std::chrono::steady_clock::now() - graphStart);
+}
+
+void LoaderGraph::RunLoader(LoaderId id, TimePoint graphStart)
+{
+    Loader& loader = _loaders[id];
+    TC_LOG_INFO("server.loading", "Loading {}...", loader.Name);
+
+    loader.Start = std::chrono::duration_cast<Milliseconds>(std::chrono::steady_clock::now() - graphStart);
+    loader.Function();
+    loader.End = std::chrono::duration_cast<Milliseconds>(std::chrono::steady_clock::now() - graphStart);
+}
+
+std::vector<LoaderGraph::LoaderId> LoaderGraph::GetCriticalPath() const
+{
+    std::vector<LoaderId> path;
+    if (_loaders.empty())
+        return path;
+
+    auto finishedLast = [this](LoaderId left, LoaderId right) { return _loaders[left].End < _loaders[right].End; };
+
+    LoaderId current = 0;
+    for (LoaderId id = 1; id < _loaders.size(); ++id)
+        if (finishedLast(current, id))
+            current = id;
+
+    for (;;)
+    {
+        path.push_back(current);
+        std::vector<LoaderId> const& dependencies = _loaders[current].Dependencies;
+        if (dependencies.empty())
+            break;
+
+        current = *std::max_element(dependencies.begin(), dependencies.end(), finishedLast);
+    }
+
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+void LoaderGraph::LogReport() const
+{
+    TC_LOG_INFO("server.loading", ">> {} loaders finished in {} ms using {} thread(s)", _loaders.size(), _totalDuration.count(), _threadCount);
+
+    std::vector<LoaderId> byDuration(_loaders.size());
+    for (LoaderId id = 0; id < _loaders.size(); ++id)
+        byDuration[id] = id;
+
+    std::stable_sort(byDuration.begin(), byDuration.end(), [this](LoaderId left, LoaderId right) { return GetDuration(left) > GetDuration(right); });
+
+    for (LoaderId id : byDuration)
+        TC_LOG_INFO("server.loading", "   {:>6} ms  {}", GetDuration(id).count(), _loaders[id].Name);
+
+    std::string criticalPath;
+    for (LoaderId id : GetCriticalPath())
+    {
+        if (!criticalPath.empty())
+            criticalPath += " -> ";
+
+        criticalPath += Trinity::StringFormat("{} ({} ms)", _loaders[id].Name, GetDuration(id).count());
+    }
+
+    TC_LOG_INFO("server.loading", ">> Critical path: {}", criticalPath);
+}
@@ -0,0 +1,69 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITYCORE_LOADER_GRAPH_H
+#define TRINITYCORE_LOADER_GRAPH_H
+
+#include "Define.h"
+#include "Duration.h"
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+/// Runs startup loaders in dependency order, loaders that don't depend on each other run concurrently.
+/// Loaders must only be added after all of their dependencies, which keeps the graph acyclic
+/// and makes insertion order a valid sequential order.
+class TC_GAME_API LoaderGraph
+{
+public:
+    typedef std::size_t LoaderId;
+
+    LoaderId Add(std::string name, std::function<void()> loader, std::initializer_list<LoaderId> dependencies = {});
+
+    /// Blocks until every loader finished, threadCount <= 1 runs them one by one in insertion order
+    void Run(std::size_t threadCount);
+
+    /// Logs time spent in each loader and the chain of dependencies that determined total load time
+    void LogReport() const;
+
+    std::string const& GetName(LoaderId id) const { return _loaders[id].Name; }
+    Milliseconds GetDuration(LoaderId id) const { return _loaders[id].End - _loaders[id].Start; }
+    Milliseconds GetTotalDuration() const { return _totalDuration; }
+
+    /// Loaders that determined total load time, in execution order
+    std::vector<LoaderId> GetCriticalPath() const;
+
+private:
+    struct Loader
+    {
+        std::string Name;
+        std::function<void()> Function;
+        std::vector<LoaderId> Dependencies;
+        std::vector<LoaderId> Dependents;
+        Milliseconds Start = Milliseconds::zero(); // relative to start of Run
+        Milliseconds End = Milliseconds::zero();
+    };
+
+    void RunLoader(LoaderId id, TimePoint graphStart);
+
+    std::vector<Loader> _loaders;
+    Milliseconds _totalDuration = Milliseconds::zero();
+    std::size_t _threadCount = 1;
+};
+
+#endif // TRINITYCORE_LOADER_GRAPH_H
@@ -40,6 +40,7 @@
 #include "CreatureGroups.h"
 #include "CreatureTextMgr.h"
 #include "DatabaseEnv.h"
+#include "DBUpdater.h"
 #include "DisableMgr.h"
 #include "GameEventMgr.h"
 #include "GameObjectModel.h"
@@ -52,6 +53,7 @@
 #include "IPLocation.h"
 #include "Language.h"
 #include "LFGMgr.h"
+#include "LoaderGraph.h"
 #include "Log.h"
 #include "LootItemStorage.h"
 #include "LootMgr.h"
@@ -1410,6 +1412,7 @@ void World::LoadConfigSettings(bool reload)
     }
 
     m_bool_configs[CONFIG_ENABLE_MMAPS] = sConfigMgr->GetBoolDefault("mmap.enablePathFinding", true);
+    m_bool_configs[CONFIG_ENABLE_MMAPS_ASYNC] = sConfigMgr->GetBoolDefault("mmap.asyncPathFinding", false);
     TC_LOG_INFO("server.loading", "WORLD: MMap data directory is: {}mmaps", m_dataPath);
 
     m_bool_configs[CONFIG_VMAP_INDOOR_CHECK] = sConfigMgr->GetBoolDefault("vmap.enableIndoorCheck", false);
@@ -1446,6 +1449,9 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_SHOW_MUTE_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowMuteInWorld", false);
     m_bool_configs[CONFIG_SHOW_BAN_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowBanInWorld", false);
     m_int_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 1);
+    m_int_configs[CONFIG_LOADING_THREADS] = sConfigMgr->GetIntDefault("Loading.Threads", 1);
+    m_bool_configs[CONFIG_WORLD_DATABASE_SNAPSHOT] = sConfigMgr->GetBoolDefault("WorldDatabase.Snapshot", false);
+    m_int_configs[CONFIG_MAP_UPDATE_CONTINENT_SLICES] = sConfigMgr->GetIntDefault("MapUpdate.Continents.UpdateSlices", 0);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetIntDefault("Command.LookupMaxResults", 0);
 
     // Warden
@@ -1586,6 +1592,10 @@ void World::SetInitialWorldSettings()
     ///- Initialize config settings
     LoadConfigSettings();
 
+    ///- Answer world database queries from the snapshot of the previous startup if no update was applied since
+    if (getBoolConfig(CONFIG_WORLD_DATABASE_SNAPSHOT))
+        WorldDatabase.OpenSnapshot(m_dataPath + "world_database.snapshot", DBUpdater<WorldDatabaseConnection>::GetAppliedUpdatesHash(WorldDatabase));
+
     ///- Initialize Allowed Security Level
     LoadDBAllowedSecurityLevel();
 
@@ -1957,126 +1967,98 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading Player level dependent mail rewards...");
     sObjectMgr->LoadMailLevelRewards();
 
-    // Loot tables
-    LoadLootTables();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Perfection Data Table...");
-    LoadSkillPerfectItemTable();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Fishing base level requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
-
-    TC_LOG_INFO("server.loading", "Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
-    TC_LOG_INFO("server.loading", "Loading Achievement Criteria Lists...");
-    sAchievementMgr->LoadAchievementCriteriaList();
-    TC_LOG_INFO("server.loading", "Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
-    TC_LOG_INFO("server.loading", "Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
-    TC_LOG_INFO("server.loading", "Loading Achievement Reward Locales...");
-    sAchievementMgr->LoadRewardLocales();
-    TC_LOG_INFO("server.loading", "Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
-
-    ///- Load dynamic data tables from the database
-    TC_LOG_INFO("server.loading", "Loading Item Auctions...");
-    sAuctionMgr->LoadAuctionItems();
-
-    TC_LOG_INFO("server.loading", "Loading Auctions...");
-    sAuctionMgr->LoadAuctions();
-
-    TC_LOG_INFO("server.loading", "Loading Guilds...");
-    sGuildMgr->LoadGuilds();
-
-    TC_LOG_INFO("server.loading", "Loading ArenaTeams...");
-    sArenaTeamMgr->LoadArenaTeams();
-
-    TC_LOG_INFO("server.loading", "Loading Groups...");
-    sGroupMgr->LoadGroups();
-
-    TC_LOG_INFO("server.loading", "Loading ReservedNames...");
-    sObjectMgr->LoadReservedPlayersNames();
-
-    TC_LOG_INFO("server.loading", "Loading GameObjects for quests...");
-    sObjectMgr->LoadGameObjectForQuests();
-
     TC_LOG_INFO("server.loading", "Loading BattleMasters...");
-    sBattlegroundMgr->LoadBattleMastersEntry();                 // must be after load CreatureTemplate
-
-    TC_LOG_INFO("server.loading", "Loading GameTeleports...");
-    sObjectMgr->LoadGameTele();
-
-    TC_LOG_INFO("server.loading", "Loading Trainers...");       // must be after LoadCreatureTemplates
-    sObjectMgr->LoadTrainers();
-
-    TC_LOG_INFO("server.loading", "Loading Creature default trainers...");
-    sObjectMgr->LoadCreatureDefaultTrainers();
-
-    TC_LOG_INFO("server.loading", "Loading Gossip menu...");
-    sObjectMgr->LoadGossipMenu();
-
-    TC_LOG_INFO("server.loading", "Loading Gossip menu options...");
-    sObjectMgr->LoadGossipMenuItems();                           // must be after LoadTrainers
+    sBattlegroundMgr->LoadBattleMastersEntry();                 // must be after load CreatureTemplate, strips npcflag read by Trainers, Gossip menu options and Vendors
 
-    TC_LOG_INFO("server.loading", "Loading Vendors...");
-    sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
-
-    TC_LOG_INFO("server.loading", "Loading Waypoints...");
-    sWaypointMgr->Load();
+    ///- Tables below only depend on data loaded above and on their listed dependencies, independent ones are loaded concurrently
+    ///- Loaders must not modify data other loaders read (templates included), such loaders go above
+    {
+        LoaderGraph loaders;
 
-    TC_LOG_INFO("server.loading", "Loading SmartAI Waypoints...");
-    sSmartWaypointMgr->LoadFromDB();
+        LoaderGraph::LoaderId lootTables = loaders.Add("Loot tables", []() { LoadLootTables(); });
+        loaders.Add("Skill Discovery Table", []() { LoadSkillDiscoveryTable(); });
+        loaders.Add("Skill Extra Item Table", []() { LoadSkillExtraItemTable(); });
+        loaders.Add("Skill Perfection Data Table", []() { LoadSkillPerfectItemTable(); });
+        loaders.Add("Skill Fishing base level requirements", []() { sObjectMgr->LoadFishingBaseSkillLevel(); });
 
-    TC_LOG_INFO("server.loading", "Loading Creature Formations...");
-    sFormationMgr->LoadCreatureFormations();
+        loaders.Add("Achievements", []()
+        {
+            sAchievementMgr->LoadAchievementReferenceList();
+            sAchievementMgr->LoadAchievementCriteriaList();
+            sAchievementMgr->LoadAchievementCriteriaData();
+            sAchievementMgr->LoadRewards();
+            sAchievementMgr->LoadRewardLocales();
+            sAchievementMgr->LoadCompletedAchievements();
+        });
 
-    TC_LOG_INFO("server.loading", "Loading World States...");              // must be loaded before battleground, outdoor PvP and conditions
-    LoadWorldStates();
+        ///- Load dynamic data tables from the database
+        // these create items and fill the character cache, keep them on one thread
+        loaders.Add("Auctions, Guilds, ArenaTeams and Groups", []()
+        {
+            sAuctionMgr->LoadAuctionItems();
+            sAuctionMgr->LoadAuctions();
+            sGuildMgr->LoadGuilds();
+            sArenaTeamMgr->LoadArenaTeams();
+            sGroupMgr->LoadGroups();
+        });
 
-    TC_LOG_INFO("server.loading", "Loading Conditions...");
-    sConditionMgr->LoadConditions();
+        loaders.Add("ReservedNames", []() { sObjectMgr->LoadReservedPlayersNames(); });
+        loaders.Add("GameObjects for quests", []() { sObjectMgr->LoadGameObjectForQuests(); }, { lootTables });
+        loaders.Add("GameTeleports", []() { sObjectMgr->LoadGameTele(); });
 
-    TC_LOG_INFO("server.loading", "Loading faction change achievement pairs...");
-    sObjectMgr->LoadFactionChangeAchievements();
+        LoaderGraph::LoaderId trainers = loaders.Add("Trainers", []() { sObjectMgr->LoadTrainers(); });
+        loaders.Add("Creature default trainers", []() { sObjectMgr->LoadCreatureDefaultTrainers(); }, { trainers });
+        LoaderGraph::LoaderId gossipMenu = loaders.Add("Gossip menu", []() { sObjectMgr->LoadGossipMenu(); });
+        loaders.Add("Gossip menu options", []() { sObjectMgr->LoadGossipMenuItems(); }, { trainers, gossipMenu });
 
-    TC_LOG_INFO("server.loading", "Loading faction change spell pairs...");
-    sObjectMgr->LoadFactionChangeSpells();
+        loaders.Add("Vendors", []() { sObjectMgr->LoadVendors(); });
+        loaders.Add("Waypoints", []() { sWaypointMgr->Load(); });
+        loaders.Add("SmartAI Waypoints", []() { sSmartWaypointMgr->LoadFromDB(); });
+        loaders.Add("Creature Formations", []() { sFormationMgr->LoadCreatureFormations(); });
+        loaders.Add("World States", [this]() { LoadWorldStates(); });
 
-    TC_LOG_INFO("server.loading", "Loading faction change quest pairs...");
-    sObjectMgr->LoadFactionChangeQuests();
+        loaders.Add("faction change pairs", []()
+        {
+            sObjectMgr->LoadFactionChangeAchievements();
+            sObjectMgr->LoadFactionChangeSpells();
+            sObjectMgr->LoadFactionChangeQuests();
+            sObjectMgr->LoadFactionChangeItems();
+            sObjectMgr->LoadFactionChangeReputations();
+            sObjectMgr->LoadFactionChangeTitles();
+        });
 
-    TC_LOG_INFO("server.loading", "Loading faction change item pairs...");
-    sObjectMgr->LoadFactionChangeItems();
+        loaders.Add("GM tickets and surveys", []()
+        {
+            sTicketMgr->LoadTickets();
+            sTicketMgr->LoadSurveys();
+        });
 
-    TC_LOG_INFO("server.loading", "Loading faction change reputation pairs...");
-    sObjectMgr->LoadFactionChangeReputations();
+        loaders.Add("client addons", []() { AddonMgr::LoadFromDB(); });
+        loaders.Add("Autobroadcasts", [this]() { LoadAutobroadcasts(); });
 
-    TC_LOG_INFO("server.loading", "Loading faction change title pairs...");
-    sObjectMgr->LoadFactionChangeTitles();
+        LoaderGraph::LoaderId creatureTexts = loaders.Add("Creature Texts", []() { sCreatureTextMgr->LoadCreatureTexts(); });
+        loaders.Add("Creature Text Locales", []() { sCreatureTextMgr->LoadCreatureTextLocales(); }, { creatureTexts });
 
-    TC_LOG_INFO("server.loading", "Loading GM tickets...");
-    sTicketMgr->LoadTickets();
+        // every loading thread holds a synch connection, extra ones would only spin waiting for a free one
+        uint32 loadingThreads = getIntConfig(CONFIG_LOADING_THREADS);
+        uint32 const worldSynchThreads = std::max<uint32>(sConfigMgr->GetIntDefault("WorldDatabase.SynchThreads", 1), 1);
+        if (loadingThreads > worldSynchThreads)
+        {
+            TC_LOG_WARN("server.loading", "Loading.Threads ({}) is higher than WorldDatabase.SynchThreads ({}), using {} loading threads", loadingThreads, worldSynchThreads, worldSynchThreads);
+            loadingThreads = worldSynchThreads;
+        }
 
-    TC_LOG_INFO("server.loading", "Loading GM surveys...");
-    sTicketMgr->LoadSurveys();
+        loaders.Run(loadingThreads);
+        loaders.LogReport();
+    }
 
-    TC_LOG_INFO("server.loading", "Loading client addons...");
-    AddonMgr::LoadFromDB();
+    TC_LOG_INFO("server.loading", "Loading Conditions...");                   // must be after everything conditions are attached to (loot, gossip, ...) and World States
+    sConditionMgr->LoadConditions();
 
     ///- Handle outdated emails (delete/return)
     TC_LOG_INFO("server.loading", "Returning old mails...");
     sObjectMgr->ReturnOrDeleteOldMails(false);
 
-    TC_LOG_INFO("server.loading", "Loading Autobroadcasts...");
-    LoadAutobroadcasts();
-
     ///- Load and initialize scripts
     sObjectMgr->LoadSpellScripts();                              // must be after load Creature/Gameobject(Template/Data)
     sObjectMgr->LoadEventScripts();                              // must be after load Creature/Gameobject(Template/Data)
@@ -2085,12 +2067,6 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading spell script names...");
     sObjectMgr->LoadSpellScriptNames();
 
-    TC_LOG_INFO("server.loading", "Loading Creature Texts...");
-    sCreatureTextMgr->LoadCreatureTexts();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Text Locales...");
-    sCreatureTextMgr->LoadCreatureTextLocales();
-
     TC_LOG_INFO("server.loading", "Initializing Scripts...");
     sScriptMgr->Initialize();
     sScriptMgr->OnConfigLoad(false);                                // must be done after the ScriptMgr has been properly initialized
@@ -2238,6 +2214,9 @@ void World::SetInitialWorldSettings()
         });
     }
 
+    ///- Later queries are not part of startup, keep them out of the snapshot
+    WorldDatabase.CloseSnapshot();
+
     uint32 startupDuration = GetMSTimeDiffToNow(startupBegin);
 
     TC_LOG_INFO("server.worldserver", "World initialized in {} minutes {} seconds", (startupDuration / 60000), ((startupDuration % 60000) / 1000));
@@ -154,6 +154,7 @@ enum WorldBoolConfigs : uint32
     CONFIG_QUEST_ENABLE_QUEST_TRACKER,
     CONFIG_WARDEN_ENABLED,
     CONFIG_ENABLE_MMAPS,
+    CONFIG_ENABLE_MMAPS_ASYNC,
     CONFIG_WINTERGRASP_ENABLE,
     CONFIG_EVENT_ANNOUNCE,
     CONFIG_STATS_LIMITS_ENABLE,
@@ -178,6 +179,7 @@ enum WorldBoolConfigs : uint32
     CONFIG_RESPAWN_DYNAMIC_ESCORTNPC,
     CONFIG_REGEN_HP_CANNOT_REACH_TARGET_IN_RAID,
     CONFIG_ALLOW_LOGGING_IP_ADDRESSES_IN_DATABASE,
+    CONFIG_WORLD_DATABASE_SNAPSHOT,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -331,6 +333,8 @@ enum WorldIntConfigs : uint32
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_LOADING_THREADS,
+    CONFIG_MAP_UPDATE_CONTINENT_SLICES,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_CLIENTCACHE_VERSION,
@@ -43,9 +43,9 @@ bool DBCStorageBase::Load(char const* path, char**& indexTable)
     // load raw non-string data
     _dataTable = dbc.AutoProduceData(_fileFormat, _indexTableSize, indexTable);
 
-    // load strings from dbc data
-    if (char* stringBlock = dbc.AutoProduceStrings(_fileFormat, _dataTable))
-        _stringPool.push_back(stringBlock);
+    // load strings from dbc data, records used in place and strings keep pointing into the mapped file
+    if (dbc.AutoProduceStrings(_fileFormat, _dataTable) || dbc.CanUseRecordsInPlace(_fileFormat))
+        _mappedFiles.push_back(dbc.GetStorage());
 
     // error in dbc file at loading if NULL
     return indexTable != nullptr;
@@ -62,9 +62,9 @@ bool DBCStorageBase::LoadStringsFrom(char const* path, char** indexTable)
     if (!dbc.Load(path, _fileFormat))
         return false;
 
-    // load strings from another locale dbc data
-    if (char* stringBlock = dbc.AutoProduceStrings(_fileFormat, _dataTable))
-        _stringPool.push_back(stringBlock);
+    // load strings from another locale dbc data, keep the file mapped only if any string now points into it
+    if (dbc.AutoProduceStrings(_fileFormat, _dataTable))
+        _mappedFiles.push_back(dbc.GetStorage());
 
     return true;
 }
@@ -21,6 +21,7 @@
 #include "Common.h"
 #include "DBCStorageIterator.h"
 #include "Errors.h"
+#include <memory>
 #include <vector>
 
  /// Interface class for common access
@@ -46,6 +47,7 @@ class TC_SHARED_API DBCStorageBase
         char const* _fileFormat;
         char* _dataTable;
         std::vector<char*> _stringPool;
+        std::vector<std::shared_ptr<void>> _mappedFiles;   // dbc files records or strings are read from
         uint32 _indexTableSize;
 };
 
@@ -29,6 +29,10 @@ using boost::asio::ip::tcp;
 
 #define TRINITY_MAX_LISTEN_CONNECTIONS boost::asio::socket_base::max_listen_connections
 
+#ifdef SO_REUSEPORT
+#define TRINITY_ACCEPTOR_REUSE_PORT
+#endif
+
 class AsyncAcceptor
 {
 public:
@@ -70,7 +74,8 @@ public:
         });
     }
 
-    bool Bind()
+    /// reusePort allows several acceptors to listen on the same endpoint, the kernel spreads incoming connections between them
+    bool Bind(bool reusePort = false)
     {
         boost::system::error_code errorCode;
         _acceptor.open(_endpoint.protocol(), errorCode);
@@ -89,6 +94,21 @@ public:
         }
 #endif
 
+        if (reusePort)
+        {
+#ifdef TRINITY_ACCEPTOR_REUSE_PORT
+            _acceptor.set_option(boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true), errorCode);
+            if (errorCode)
+            {
+                TC_LOG_INFO("network", "Failed to set reuse_port option on acceptor {}", errorCode.message());
+                return false;
+            }
+#else
+            TC_LOG_INFO("network", "reuse_port option is not supported on this platform");
+            return false;
+#endif
+        }
+
         _acceptor.bind(_endpoint, errorCode);
         if (errorCode)
         {
@@ -23,6 +23,8 @@
 #include "Errors.h"
 #include "IoContext.h"
 #include "Log.h"
+#include "Metric.h"
+#include "ProcessPriority.h"
 #include "Timer.h"
 #include <boost/asio/ip/tcp.hpp>
 #include <atomic>
@@ -30,6 +32,7 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <string>
 #include <thread>
 
 using boost::asio::ip::tcp;
@@ -38,7 +41,7 @@ template<class SocketType>
 class NetworkThread
 {
 public:
-    NetworkThread() : _connections(0), _stopped(false), _thread(nullptr), _ioContext(1),
+    NetworkThread() : _connections(0), _stopped(false), _thread(nullptr), _index(0), _processor(-1), _ioContext(1),
         _acceptSocket(_ioContext), _updateTimer(_ioContext)
     {
     }
@@ -93,6 +96,14 @@ public:
 
     tcp::socket* GetSocketForAccept() { return &_acceptSocket; }
 
+    Trinity::Asio::IoContext& GetIoContext() { return _ioContext; }
+
+    /// Index used to tag metrics reported by this thread
+    void SetIndex(uint32 index) { _index = index; }
+
+    /// Processor the thread binds itself to when started, -1 leaves scheduling to the OS
+    void SetProcessor(int32 processor) { _processor = processor; }
+
 protected:
     virtual void SocketAdded(std::shared_ptr<SocketType> /*sock*/) { }
     virtual void SocketRemoved(std::shared_ptr<SocketType> /*sock*/) { }
@@ -122,6 +133,11 @@ protected:
     {
         TC_LOG_DEBUG("misc", "Network Thread Starting");
 
+        if (_processor >= 0)
+            SetCurrentThreadAffinity("network", uint32(_processor));
+
+        _nextMetricLog = std::chrono::steady_clock::now();
+
         _updateTimer.expires_from_now(boost::posix_time::milliseconds(1));
         _updateTimer.async_wait([this](boost::system::error_code const&) { Update(); });
         _ioContext.run();
@@ -156,6 +172,33 @@ protected:
 
             return false;
         }), _sockets.end());
+
+        LogMetrics();
+    }
+
+    void LogMetrics()
+    {
+        if (!sMetric->IsEnabled())
+            return;
+
+        TimePoint now = std::chrono::steady_clock::now();
+        if (now < _nextMetricLog)
+            return;
+
+        _nextMetricLog = now + Seconds(1);
+
+        uint64 writeQueueSize = 0;
+        uint64 writeQueueBytes = 0;
+        for (std::shared_ptr<SocketType> const& sock : _sockets)
+        {
+            writeQueueSize += sock->GetWriteQueueSize();
+            writeQueueBytes += sock->GetWriteQueueBytes();
+        }
+
+        std::string thread = std::to_string(_index);
+        TC_METRIC_VALUE("network_connections", uint64(_sockets.size()), TC_METRIC_TAG("network_thread", thread));
+        TC_METRIC_VALUE("network_write_queue_size", writeQueueSize, TC_METRIC_TAG("network_thread", thread));
+        TC_METRIC_VALUE("network_write_queue_bytes", writeQueueBytes, TC_METRIC_TAG("network_thread", thread));
     }
 
 private:
@@ -165,6 +208,9 @@ private:
     std::atomic<bool> _stopped;
 
     std::thread* _thread;
+    uint32 _index;
+    int32 _processor;
+    TimePoint _nextMetricLog;
 
     SocketContainer _sockets;
 
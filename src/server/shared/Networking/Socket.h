@@ -20,8 +20,9 @@
 
 #include "MessageBuffer.h"
 #include "Log.h"
+#include <algorithm>
 #include <atomic>
-#include <queue>
+#include <deque>
 #include <memory>
 #include <functional>
 #include <type_traits>
@@ -30,6 +31,8 @@
 using boost::asio::ip::tcp;
 
 #define READ_BLOCK_SIZE 4096
+#define WRITE_GATHER_MAX_BUFFERS 16
+#define WRITE_GATHER_MAX_BYTES 262144
 #ifdef BOOST_ASIO_HAS_IOCP
 #define TC_SOCKET_USE_IOCP
 #endif
@@ -39,7 +42,8 @@ class Socket : public std::enable_shared_from_this<T>
 {
 public:
     explicit Socket(tcp::socket&& socket) : _socket(std::move(socket)), _remoteAddress(_socket.remote_endpoint().address()),
-        _remotePort(_socket.remote_endpoint().port()), _readBuffer(), _closed(false), _closing(false), _isWritingAsync(false)
+        _remotePort(_socket.remote_endpoint().port()), _readBuffer(), _writeQueueBytes(0), _writeGatherMaxBuffers(WRITE_GATHER_MAX_BUFFERS),
+        _writeGatherMaxBytes(WRITE_GATHER_MAX_BYTES), _closed(false), _closing(false), _isWritingAsync(false)
     {
         _readBuffer.Resize(READ_BLOCK_SIZE);
     }
@@ -103,7 +107,8 @@ public:
 
     void QueuePacket(MessageBuffer&& buffer)
     {
-        _writeQueue.push(std::move(buffer));
+        _writeQueueBytes += buffer.GetActiveSize();
+        _writeQueue.push_back(std::move(buffer));
 
 #ifdef TC_SOCKET_USE_IOCP
         AsyncProcessQueue();
@@ -138,6 +143,16 @@ public:
 
     MessageBuffer& GetReadBuffer() { return _readBuffer; }
 
+    std::size_t GetWriteQueueSize() const { return _writeQueue.size(); }
+    std::size_t GetWriteQueueBytes() const { return _writeQueueBytes; }
+
+    /// Limits how many queued buffers (and bytes) are handed to a single write call
+    void SetWriteGatherLimits(std::size_t maxBuffers, std::size_t maxBytes)
+    {
+        _writeGatherMaxBuffers = std::max<std::size_t>(maxBuffers, 1);
+        _writeGatherMaxBytes = maxBytes;
+    }
+
 protected:
     virtual void OnClose() { }
 
@@ -151,8 +166,8 @@ protected:
         _isWritingAsync = true;
 
 #ifdef TC_SOCKET_USE_IOCP
-        MessageBuffer& buffer = _writeQueue.front();
-        _socket.async_write_some(boost::asio::buffer(buffer.GetReadPointer(), buffer.GetActiveSize()), std::bind(&Socket<T>::WriteHandler,
+        GatherWriteBuffers();
+        _socket.async_write_some(_writeBuffers, std::bind(&Socket<T>::WriteHandler,
             this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
 #else
         _socket.async_write_some(boost::asio::null_buffers(), std::bind(&Socket<T>::WriteHandlerWrapper,
@@ -184,6 +199,48 @@ private:
         ReadHandler();
     }
 
+    /// Collects queued buffers into _writeBuffers for one vectored write, always including the front buffer
+    std::size_t GatherWriteBuffers()
+    {
+        _writeBuffers.clear();
+
+        std::size_t bytes = 0;
+        for (MessageBuffer& buffer : _writeQueue)
+        {
+            if (!_writeBuffers.empty() && (_writeBuffers.size() >= _writeGatherMaxBuffers || bytes + buffer.GetActiveSize() > _writeGatherMaxBytes))
+                break;
+
+            _writeBuffers.emplace_back(buffer.GetReadPointer(), buffer.GetActiveSize());
+            bytes += buffer.GetActiveSize();
+        }
+
+        return bytes;
+    }
+
+    /// Marks bytes written by a vectored write as sent, dropping fully sent buffers
+    void WriteCompleted(std::size_t bytes)
+    {
+        _writeQueueBytes -= bytes;
+
+        while (!_writeQueue.empty())
+        {
+            MessageBuffer& buffer = _writeQueue.front();
+            if (buffer.GetActiveSize())
+            {
+                if (!bytes)
+                    break;
+
+                std::size_t consumed = std::min(bytes, buffer.GetActiveSize());
+                buffer.ReadCompleted(consumed);
+                bytes -= consumed;
+                if (buffer.GetActiveSize())
+                    break;
+            }
+
+            _writeQueue.pop_front();
+        }
+    }
+
 #ifdef TC_SOCKET_USE_IOCP
 
     void WriteHandler(boost::system::error_code error, std::size_t transferedBytes)
@@ -191,9 +248,7 @@ private:
         if (!error)
         {
             _isWritingAsync = false;
-            _writeQueue.front().ReadCompleted(transferedBytes);
-            if (!_writeQueue.front().GetActiveSize())
-                _writeQueue.pop();
+            WriteCompleted(transferedBytes);
 
             if (!_writeQueue.empty())
                 AsyncProcessQueue();
@@ -217,42 +272,45 @@ private:
         if (_writeQueue.empty())
             return false;
 
-        MessageBuffer& queuedMessage = _writeQueue.front();
-
-        std::size_t bytesToSend = queuedMessage.GetActiveSize();
+        std::size_t bytesToSend = GatherWriteBuffers();
 
         boost::system::error_code error;
-        std::size_t bytesSent = _socket.write_some(boost::asio::buffer(queuedMessage.GetReadPointer(), bytesToSend), error);
+        std::size_t bytesSent = _socket.write_some(_writeBuffers, error);
 
         if (error)
         {
             if (error == boost::asio::error::would_block || error == boost::asio::error::try_again)
                 return AsyncProcessQueue();
 
-            _writeQueue.pop();
+            PopWriteQueue();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
         else if (bytesSent == 0)
         {
-            _writeQueue.pop();
+            PopWriteQueue();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
-        else if (bytesSent < bytesToSend) // now n > 0
-        {
-            queuedMessage.ReadCompleted(bytesSent);
+
+        WriteCompleted(bytesSent);
+
+        if (bytesSent < bytesToSend) // now n > 0
             return AsyncProcessQueue();
-        }
 
-        _writeQueue.pop();
         if (_closing && _writeQueue.empty())
             CloseSocket();
         return !_writeQueue.empty();
     }
 
+    void PopWriteQueue()
+    {
+        _writeQueueBytes -= _writeQueue.front().GetActiveSize();
+        _writeQueue.pop_front();
+    }
+
 #endif
 
     tcp::socket _socket;
@@ -261,7 +319,11 @@ private:
     uint16 _remotePort;
 
     MessageBuffer _readBuffer;
-    std::queue<MessageBuffer> _writeQueue;
+    std::deque<MessageBuffer> _writeQueue;
+    std::size_t _writeQueueBytes;
+    std::vector<boost::asio::const_buffer> _writeBuffers;
+    std::size_t _writeGatherMaxBuffers;
+    std::size_t _writeGatherMaxBytes;
 
     std::atomic<bool> _closed;
     std::atomic<bool> _closing;
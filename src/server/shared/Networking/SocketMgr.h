@@ -22,7 +22,10 @@
 #include "Errors.h"
 #include "NetworkThread.h"
 #include <boost/asio/ip/tcp.hpp>
+#include <algorithm>
 #include <memory>
+#include <thread>
+#include <vector>
 
 using boost::asio::ip::tcp;
 
@@ -32,48 +35,64 @@ class SocketMgr
 public:
     virtual ~SocketMgr()
     {
-        ASSERT(!_threads && !_acceptor && !_threadCount, "StopNetwork must be called prior to SocketMgr destruction");
+        ASSERT(!_threads && _acceptors.empty() && !_threadCount, "StopNetwork must be called prior to SocketMgr destruction");
     }
 
     virtual bool StartNetwork(Trinity::Asio::IoContext& ioContext, std::string const& bindIp, uint16 port, int threadCount)
     {
         ASSERT(threadCount > 0);
 
-        AsyncAcceptor* acceptor = nullptr;
-        try
-        {
-            acceptor = new AsyncAcceptor(ioContext, bindIp, port);
-        }
-        catch (boost::system::system_error const& err)
+        _threadCount = threadCount;
+        _threads = CreateThreads();
+
+        ASSERT(_threads);
+
+        bool acceptorPerThread = _acceptorPerThread && _threadCount > 1;
+#ifndef TRINITY_ACCEPTOR_REUSE_PORT
+        if (acceptorPerThread)
         {
-            TC_LOG_ERROR("network", "Exception caught in SocketMgr.StartNetwork ({}:{}): {}", bindIp, port, err.what());
-            return false;
+            TC_LOG_WARN("network", "StartNetwork: one acceptor per network thread is not supported on this platform, using a single acceptor");
+            acceptorPerThread = false;
         }
+#endif
 
-        if (!acceptor->Bind())
+        if (acceptorPerThread)
         {
-            TC_LOG_ERROR("network", "StartNetwork failed to bind socket acceptor");
-            delete acceptor;
-            return false;
-        }
+            // every thread accepts on its own socket bound with SO_REUSEPORT, the kernel balances new connections between them
+            for (int32 i = 0; i < _threadCount; ++i)
+            {
+                if (!CreateAcceptor(_threads[i].GetIoContext(), bindIp, port, true))
+                    return false;
 
-        _acceptor = acceptor;
-        _threadCount = threadCount;
-        _threads = CreateThreads();
+                uint32 threadIndex = uint32(i);
+                _acceptors.back()->SetSocketFactory([this, threadIndex]() { return std::make_pair(_threads[threadIndex].GetSocketForAccept(), threadIndex); });
+            }
+        }
+        else
+        {
+            if (!CreateAcceptor(ioContext, bindIp, port, false))
+                return false;
 
-        ASSERT(_threads);
+            _acceptors.back()->SetSocketFactory([this]() { return GetSocketForAccept(); });
+        }
 
+        uint32 processorCount = std::max(std::thread::hardware_concurrency(), 1u);
         for (int32 i = 0; i < _threadCount; ++i)
-            _threads[i].Start();
+        {
+            _threads[i].SetIndex(i);
+            if (_threadAffinity)
+                _threads[i].SetProcessor(i % processorCount);
 
-        _acceptor->SetSocketFactory([this]() { return GetSocketForAccept(); });
+            _threads[i].Start();
+        }
 
         return true;
     }
 
     virtual void StopNetwork()
     {
-        _acceptor->Close();
+        for (AsyncAcceptor* acceptor : _acceptors)
+            acceptor->Close();
 
         if (_threadCount != 0)
             for (int32 i = 0; i < _threadCount; ++i)
@@ -81,8 +100,7 @@ public:
 
         Wait();
 
-        delete _acceptor;
-        _acceptor = nullptr;
+        DeleteAcceptors();
         delete[] _threads;
         _threads = nullptr;
         _threadCount = 0;
@@ -130,15 +148,67 @@ public:
     }
 
 protected:
-    SocketMgr() : _acceptor(nullptr), _threads(nullptr), _threadCount(0)
+    SocketMgr() : _threads(nullptr), _threadCount(0), _acceptorPerThread(false), _threadAffinity(false)
     {
     }
 
     virtual NetworkThread<SocketType>* CreateThreads() const = 0;
 
-    AsyncAcceptor* _acceptor;
+    template<AsyncAcceptor::AcceptCallback acceptCallback>
+    void AsyncAcceptWithCallback()
+    {
+        for (AsyncAcceptor* acceptor : _acceptors)
+            acceptor->AsyncAcceptWithCallback<acceptCallback>();
+    }
+
+    std::vector<AsyncAcceptor*> _acceptors;
     NetworkThread<SocketType>* _threads;
     int32 _threadCount;
+    bool _acceptorPerThread;
+    bool _threadAffinity;
+
+private:
+    bool CreateAcceptor(Trinity::Asio::IoContext& ioContext, std::string const& bindIp, uint16 port, bool reusePort)
+    {
+        AsyncAcceptor* acceptor = nullptr;
+        try
+        {
+            acceptor = new AsyncAcceptor(ioContext, bindIp, port);
+        }
+        catch (boost::system::system_error const& err)
+        {
+            TC_LOG_ERROR("network", "Exception caught in SocketMgr.StartNetwork ({}:{}): {}", bindIp, port, err.what());
+            AbortStart();
+            return false;
+        }
+
+        if (!acceptor->Bind(reusePort))
+        {
+            TC_LOG_ERROR("network", "StartNetwork failed to bind socket acceptor");
+            delete acceptor;
+            AbortStart();
+            return false;
+        }
+
+        _acceptors.push_back(acceptor);
+        return true;
+    }
+
+    void AbortStart()
+    {
+        DeleteAcceptors();
+        delete[] _threads;
+        _threads = nullptr;
+        _threadCount = 0;
+    }
+
+    void DeleteAcceptors()
+    {
+        for (AsyncAcceptor* acceptor : _acceptors)
+            delete acceptor;
+
+        _acceptors.clear();
+    }
 };
 
 #endif // SocketMgr_h__
@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "ByteConverter.h"
+#include "PacketBufferPool.h"
 #include <array>
 #include <string>
 #include <vector>
@@ -92,6 +93,9 @@ class TC_SHARED_API ByteBuffer
 
         ByteBuffer(MessageBuffer&& buffer);
 
+        // takes over storage filled elsewhere, its contents become readable and further writes are appended
+        explicit ByteBuffer(PacketStorage&& storage) noexcept : _rpos(0), _wpos(storage.size()), _storage(std::move(storage)) { }
+
         ByteBuffer& operator=(ByteBuffer const& right)
         {
             if (this != &right)
@@ -126,6 +130,13 @@ class TC_SHARED_API ByteBuffer
             _rpos = _wpos = 0;
         }
 
+        // releases storage (capacity included) so it can be reused elsewhere
+        PacketStorage&& Move() noexcept
+        {
+            _rpos = _wpos = 0;
+            return std::move(_storage);
+        }
+
         template <typename T> void append(T value)
         {
             static_assert(std::is_fundamental<T>::value, "append(compound)");
@@ -490,7 +501,7 @@ class TC_SHARED_API ByteBuffer
 
     protected:
         size_t _rpos, _wpos;
-        std::vector<uint8> _storage;
+        PacketStorage _storage;
 };
 
 /// @todo Make a ByteBuffer.cpp and move all this inlining to it.
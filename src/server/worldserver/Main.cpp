@@ -40,6 +40,7 @@
 #include "ObjectAccessor.h"
 #include "OpenSSLCrypto.h"
 #include "OutdoorPvP/OutdoorPvPMgr.h"
+#include "PacketBufferPool.h"
 #include "ProcessPriority.h"
 #include "RASession.h"
 #include "RealmList.h"
@@ -62,6 +63,7 @@
 #include <boost/program_options.hpp>
 #include <csignal>
 #include <iostream>
+#include <thread>
 
 using namespace boost::program_options;
 namespace fs = boost::filesystem;
@@ -302,6 +304,12 @@ extern int main(int argc, char** argv)
         TC_METRIC_VALUE("db_queue_login", uint64(LoginDatabase.QueueSize()));
         TC_METRIC_VALUE("db_queue_character", uint64(CharacterDatabase.QueueSize()));
         TC_METRIC_VALUE("db_queue_world", uint64(WorldDatabase.QueueSize()));
+
+        Trinity::PacketBufferPool::Stats packetBuffers = Trinity::PacketBufferPool::GetStats();
+        TC_METRIC_VALUE("packet_buffer_allocations", packetBuffers.Allocations);
+        TC_METRIC_VALUE("packet_buffer_system_allocations", packetBuffers.SystemAllocations);
+        TC_METRIC_VALUE("packet_buffer_shared_transfers", packetBuffers.SharedPoolTransfers);
+        TC_METRIC_VALUE("packet_buffer_pooled_bytes", packetBuffers.PooledBytes);
     });
 
     TC_METRIC_EVENT("events", "Worldserver started", "");
@@ -356,13 +364,17 @@ extern int main(int argc, char** argv)
 
     int networkThreads = sConfigMgr->GetIntDefault("Network.Threads", 1);
 
-    if (networkThreads <= 0)
+    if (networkThreads < 0)
     {
-        TC_LOG_ERROR("server.worldserver", "Network.Threads must be greater than 0");
+        TC_LOG_ERROR("server.worldserver", "Network.Threads must be 0 or greater");
         World::StopNow(ERROR_EXIT_CODE);
         return 1;
     }
 
+    // 0 means one network thread per processor
+    if (!networkThreads)
+        networkThreads = std::max<int>(std::thread::hardware_concurrency(), 1);
+
     if (!sWorldSocketMgr.StartWorldNetwork(*ioContext, worldListener, worldPort, networkThreads))
     {
         TC_LOG_ERROR("server.worldserver", "Failed to initialize network");
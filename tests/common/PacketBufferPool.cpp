@@ -0,0 +1,103 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "ByteBuffer.h"
+#include "MessageBuffer.h"
+#include "PacketBufferPool.h"
+#include <thread>
+#include <vector>
+
+using Trinity::PacketBufferPool;
+
+TEST_CASE("Block sizes", "[PacketBufferPool]")
+{
+    REQUIRE(PacketBufferPool::GetBlockSize(1) == PacketBufferPool::MinBlockSize);
+    REQUIRE(PacketBufferPool::GetBlockSize(64) == 64);
+    REQUIRE(PacketBufferPool::GetBlockSize(65) == 128);
+    REQUIRE(PacketBufferPool::GetBlockSize(200) == 256);
+    REQUIRE(PacketBufferPool::GetBlockSize(4096) == 4096);
+    REQUIRE(PacketBufferPool::GetBlockSize(PacketBufferPool::MaxBlockSize) == PacketBufferPool::MaxBlockSize);
+    REQUIRE(PacketBufferPool::GetBlockSize(PacketBufferPool::MaxBlockSize + 1) == PacketBufferPool::MaxBlockSize + 1);
+}
+
+TEST_CASE("Freed blocks are reused", "[PacketBufferPool]")
+{
+    SECTION("same thread")
+    {
+        void* first = PacketBufferPool::Allocate(300);
+        PacketBufferPool::Deallocate(first, 300);
+
+        // any request of the same size class gets the block back
+        void* second = PacketBufferPool::Allocate(400);
+        REQUIRE(second == first);
+        PacketBufferPool::Deallocate(second, 400);
+    }
+
+    SECTION("freed on another thread")
+    {
+        std::vector<void*> blocks;
+        for (int i = 0; i < 64; ++i)
+            blocks.push_back(PacketBufferPool::Allocate(PacketBufferPool::MaxBlockSize));
+
+        // the other thread's cache is handed to the shared lists when it exits
+        std::thread([&blocks]()
+        {
+            for (void* block : blocks)
+                PacketBufferPool::Deallocate(block, PacketBufferPool::MaxBlockSize);
+        }).join();
+
+        uint64 systemAllocations = PacketBufferPool::GetStats().SystemAllocations;
+        for (void*& block : blocks)
+            block = PacketBufferPool::Allocate(PacketBufferPool::MaxBlockSize);
+
+        REQUIRE(PacketBufferPool::GetStats().SystemAllocations == systemAllocations);
+
+        for (void* block : blocks)
+            PacketBufferPool::Deallocate(block, PacketBufferPool::MaxBlockSize);
+    }
+}
+
+TEST_CASE("Large requests bypass the pool", "[PacketBufferPool]")
+{
+    uint64 systemAllocations = PacketBufferPool::GetStats().SystemAllocations;
+
+    void* block = PacketBufferPool::Allocate(PacketBufferPool::MaxBlockSize * 4);
+    PacketBufferPool::Deallocate(block, PacketBufferPool::MaxBlockSize * 4);
+    block = PacketBufferPool::Allocate(PacketBufferPool::MaxBlockSize * 4);
+    PacketBufferPool::Deallocate(block, PacketBufferPool::MaxBlockSize * 4);
+
+    REQUIRE(PacketBufferPool::GetStats().SystemAllocations == systemAllocations + 2);
+}
+
+TEST_CASE("Storage moves between buffers without copying", "[PacketBufferPool]")
+{
+    ByteBuffer packet;
+    packet << uint32(0x12345678) << uint8(7);
+    uint8 const* data = packet.contents();
+
+    MessageBuffer message(packet.Move());
+    REQUIRE(packet.empty());
+    REQUIRE(message.GetBasePointer() == data);
+
+    ByteBuffer adopted(message.Move());
+    REQUIRE(adopted.contents() == data);
+    REQUIRE(adopted.size() == 5);
+    REQUIRE(adopted.read<uint32>() == 0x12345678);
+    REQUIRE(adopted.read<uint8>() == 7);
+}
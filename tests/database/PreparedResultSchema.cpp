@@ -0,0 +1,164 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "QueryResult.h"
+#include "Field.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Result filled column by column the way PreparedResultSet stores fetched rows, without a MySQL statement
+    class TestPreparedResultSet : public PreparedResultSet
+    {
+    public:
+        explicit TestPreparedResultSet(uint64 rowCount) : PreparedResultSet(nullptr, nullptr, rowCount, 0) { }
+
+        template <typename T>
+        void AddColumn(DatabaseFieldTypes type, std::vector<T> const& values)
+        {
+            char* data = AddColumnStorage(type, sizeof(T));
+            std::memcpy(data, values.data(), values.size() * sizeof(T));
+            _columnLengths.emplace_back(values.size(), uint32(sizeof(T)));
+            UpdateLengths();
+        }
+
+        void AddStringColumn(std::vector<Optional<std::string>> const& values)
+        {
+            std::size_t size = 1;
+            for (Optional<std::string> const& value : values)
+                if (value)
+                    size = std::max(size, value->size());
+
+            char* data = AddColumnStorage(DatabaseFieldTypes::Binary, uint32(size));
+            std::vector<uint32> lengths;
+            for (std::size_t row = 0; row < values.size(); ++row)
+            {
+                if (values[row])
+                {
+                    std::memcpy(data + row * size, values[row]->data(), values[row]->size());
+                    lengths.push_back(uint32(values[row]->size()));
+                }
+                else
+                    lengths.push_back(NullValueLength);
+            }
+            _columnLengths.push_back(std::move(lengths));
+            UpdateLengths();
+        }
+
+    private:
+        char* AddColumnStorage(DatabaseFieldTypes type, uint32 size)
+        {
+            _buffers.push_back(std::make_unique<char[]>(size * m_rowCount));
+            char* data = _buffers.back().get();
+            std::memset(data, 0, size * m_rowCount);
+
+            QueryResultFieldMetadata meta;
+            meta.TableName = meta.TableAlias = "test";
+            meta.Name = meta.Alias = "column";
+            meta.TypeName = "TEST";
+            meta.Index = m_fieldCount;
+            meta.Type = type;
+            m_fieldMetadata.push_back(meta);
+            m_columns.push_back({ data, size });
+            ++m_fieldCount;
+            return data;
+        }
+
+        void UpdateLengths()
+        {
+            m_lengths.clear();
+            for (uint64 row = 0; row < m_rowCount; ++row)
+                for (std::vector<uint32> const& column : _columnLengths)
+                    m_lengths.push_back(column[row]);
+        }
+
+        std::vector<std::unique_ptr<char[]>> _buffers;
+        std::vector<std::vector<uint32>> _columnLengths;
+    };
+}
+
+TEST_CASE("Schema matching the result reads typed rows", "[PreparedResultSchema]")
+{
+    TestPreparedResultSet result(2);
+    result.AddColumn<uint32>(DatabaseFieldTypes::UInt32, { 10, 20 });
+    result.AddColumn<uint16>(DatabaseFieldTypes::UInt16, { 1, 2 });
+    result.AddStringColumn({ "1 2 3", "" });
+
+    using Row = PreparedResultSchema<uint32, uint16, std::string_view>;
+    REQUIRE(Row::Validate(result));
+
+    auto [guid, cost, text] = Row::GetRow(result, 1);
+    REQUIRE(guid == 20);
+    REQUIRE(cost == 2);
+    REQUIRE(text.empty());
+    REQUIRE_FALSE(result.IsNull(1, 2));
+
+    REQUIRE(std::get<2>(Row::GetRow(result, 0)) == "1 2 3");
+    REQUIRE(result.GetColumn<uint32>(0).size() == 2);
+    REQUIRE(result.GetColumn<uint32>(0)[0] == 10);
+}
+
+TEST_CASE("Schema mismatches fail validation", "[PreparedResultSchema]")
+{
+    TestPreparedResultSet result(1);
+    result.AddColumn<uint32>(DatabaseFieldTypes::UInt32, { 10 });
+    result.AddStringColumn({ "text" });
+
+    SECTION("Column count")
+    {
+        REQUIRE_FALSE(PreparedResultSchema<uint32>::Validate(result));
+        REQUIRE_FALSE((PreparedResultSchema<uint32, std::string_view, uint8>::Validate(result)));
+    }
+
+    SECTION("Signedness")
+    {
+        REQUIRE_FALSE((PreparedResultSchema<int32, std::string_view>::Validate(result)));
+    }
+
+    SECTION("Width")
+    {
+        REQUIRE_FALSE((PreparedResultSchema<uint64, std::string_view>::Validate(result)));
+    }
+
+    SECTION("Text read as number")
+    {
+        REQUIRE_FALSE((PreparedResultSchema<uint32, uint32>::Validate(result)));
+    }
+}
+
+TEST_CASE("NULL values", "[PreparedResultSchema]")
+{
+    TestPreparedResultSet result(2);
+    result.AddColumn<uint32>(DatabaseFieldTypes::UInt32, { 0, 5 });
+    result.AddStringColumn({ std::nullopt, "text" });
+
+    using Row = PreparedResultSchema<uint32, std::string_view>;
+    REQUIRE(Row::Validate(result));
+
+    REQUIRE(result.IsNull(0, 1));
+    REQUIRE(result.GetStringView(0, 1).empty());
+    REQUIRE(std::get<1>(Row::GetRow(result, 0)).empty());
+
+    REQUIRE_FALSE(result.IsNull(1, 1));
+    REQUIRE(std::get<1>(Row::GetRow(result, 1)) == "text");
+}
@@ -0,0 +1,207 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "QueryResultSnapshot.h"
+#include "Field.h"
+#include "MySQLHacks.h"
+#include "QueryResult.h"
+#include <boost/filesystem.hpp>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr char const* TestQuery = "SELECT entry, name FROM creature_template";
+    constexpr uint32 NullValueLength = 0xFFFFFFFF;
+
+    MySQLField MakeField(enum_field_types type, uint32 flags, char const* name)
+    {
+        MySQLField field = { };
+        field.type = type;
+        field.flags = flags;
+        field.org_table = field.table = const_cast<char*>("creature_template");
+        field.org_name = field.name = const_cast<char*>(name);
+        return field;
+    }
+
+    void AppendValue(std::string& rows, char const* value)
+    {
+        uint32 const length = value ? uint32(strlen(value)) : NullValueLength;
+        rows.append(reinterpret_cast<char const*>(&length), sizeof(length));
+        if (value)
+        {
+            rows.append(value, length);
+            rows.push_back('\0');
+        }
+    }
+
+    struct TestResultStorage
+    {
+        std::vector<MySQLField> Fields;
+        std::string Rows;
+    };
+
+    // Text protocol result of TestQuery with rows (1, "Hogger") and (2, NULL), built without a MySQL connection
+    ResultSet* MakeResult()
+    {
+        std::shared_ptr<TestResultStorage> storage = std::make_shared<TestResultStorage>();
+        storage->Fields = { MakeField(MYSQL_TYPE_LONG, UNSIGNED_FLAG, "entry"), MakeField(MYSQL_TYPE_VAR_STRING, 0, "name") };
+        AppendValue(storage->Rows, "1");
+        AppendValue(storage->Rows, "Hogger");
+        AppendValue(storage->Rows, "2");
+        AppendValue(storage->Rows, nullptr);
+
+        MySQLField* fields = storage->Fields.data();
+        char const* rows = storage->Rows.data();
+        return new ResultSet(fields, 2, 2, rows, std::move(storage));
+    }
+
+    void CheckResult(ResultSet* result)
+    {
+        REQUIRE(result);
+        REQUIRE(result->GetRowCount() == 2);
+        REQUIRE(result->GetFieldCount() == 2);
+
+        REQUIRE(result->NextRow());
+        Field* fields = result->Fetch();
+        REQUIRE(fields[0].GetUInt32() == 1);
+        REQUIRE(fields[1].GetString() == "Hogger");
+
+        REQUIRE(result->NextRow());
+        fields = result->Fetch();
+        REQUIRE(fields[0].GetUInt32() == 2);
+        REQUIRE(fields[1].IsNull());
+
+        REQUIRE_FALSE(result->NextRow());
+        delete result;
+    }
+
+    // Records TestQuery and a query without rows into a new snapshot at path
+    void RecordSnapshot(std::string const& path)
+    {
+        QueryResultSnapshot snapshot(path, "v1");
+        REQUIRE_FALSE(snapshot.IsLoaded());
+
+        CheckResult(snapshot.Record(TestQuery, MakeResult()));
+        REQUIRE(snapshot.Record("SELECT 1 FROM DUAL WHERE 0", nullptr) == nullptr);
+        snapshot.Close();
+    }
+
+    // Reads the recorded snapshot back through ResultSet, without misses the file is kept
+    void CheckSnapshot(std::string const& path)
+    {
+        QueryResultSnapshot snapshot(path, "v1");
+        REQUIRE(snapshot.IsLoaded());
+
+        ResultSet* result = nullptr;
+        REQUIRE(snapshot.Find(TestQuery, &result));
+        CheckResult(result);
+
+        result = nullptr;
+        REQUIRE(snapshot.Find("SELECT 1 FROM DUAL WHERE 0", &result));
+        REQUIRE(result == nullptr);
+    }
+
+    std::string SnapshotPath()
+    {
+        return (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("deleteme-%%%%-%%%%.snapshot")).string();
+    }
+}
+
+TEST_CASE("Recorded results are read back from the snapshot", "[QueryResultSnapshot]")
+{
+    std::string const path = SnapshotPath();
+    RecordSnapshot(path);
+    REQUIRE(boost::filesystem::exists(path));
+    REQUIRE_FALSE(boost::filesystem::exists(path + ".tmp"));
+
+    CheckSnapshot(path);
+
+    SECTION("Query not in the snapshot")
+    {
+        QueryResultSnapshot snapshot(path, "v1");
+        ResultSet* result = nullptr;
+        REQUIRE_FALSE(snapshot.Find("SELECT guid FROM creature", &result));
+
+        // incomplete, recorded again on the next start
+        snapshot.Close();
+        REQUIRE_FALSE(boost::filesystem::exists(path));
+    }
+
+    SECTION("Other version")
+    {
+        QueryResultSnapshot snapshot(path, "v2");
+        REQUIRE_FALSE(snapshot.IsLoaded());
+    }
+
+    SECTION("Invalidated")
+    {
+        QueryResultSnapshot snapshot(path, "v1");
+        REQUIRE(snapshot.IsLoaded());
+        snapshot.Invalidate();
+
+        ResultSet* result = nullptr;
+        REQUIRE_FALSE(snapshot.Find(TestQuery, &result));
+        snapshot.Close();
+        REQUIRE_FALSE(boost::filesystem::exists(path));
+    }
+
+    boost::filesystem::remove(path);
+}
+
+TEST_CASE("Damaged snapshots are recorded again", "[QueryResultSnapshot]")
+{
+    std::string const path = SnapshotPath();
+    RecordSnapshot(path);
+    uintmax_t const size = boost::filesystem::file_size(path);
+
+    SECTION("Truncated")
+    {
+        boost::filesystem::resize_file(path, size - 8);
+    }
+
+    SECTION("Truncated header")
+    {
+        boost::filesystem::resize_file(path, 6);
+    }
+
+    SECTION("Corrupted magic")
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.write("XXXX", 4);
+    }
+
+    SECTION("Corrupted entry count")
+    {
+        // magic, format version, version string "v1"
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(4 + 4 + 4 + 3);
+        uint32 const entryCount = 3;
+        file.write(reinterpret_cast<char const*>(&entryCount), sizeof(entryCount));
+    }
+
+    // the damaged file is rejected and replaced by a new recording
+    RecordSnapshot(path);
+    CheckSnapshot(path);
+
+    boost::filesystem::remove(path);
+}
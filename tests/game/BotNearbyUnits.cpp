@@ -0,0 +1,82 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "botnearbyunits.h"
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    struct TestMap { };
+
+    struct TestUnit
+    {
+        bool IsInWorld() const { return InWorld; }
+        TestMap const* GetMap() const { return Map; }
+        bool IsWithinDist(TestUnit const* other, float dist, bool /*is3D*/) const { return std::fabs(other->X - X) <= dist; }
+
+        TestMap const* Map;
+        float X;
+        bool InWorld = true;
+    };
+}
+
+TEST_CASE("Units that left the map mid-tick are skipped", "[NpcBots]")
+{
+    TestMap map, otherMap;
+    TestUnit bot{ &map, 0.0f };
+    TestUnit despawned{ &map, 5.0f };
+    TestUnit teleported{ &map, 10.0f };
+    TestUnit stays{ &map, 15.0f };
+    TestUnit tooFar{ &map, 50.0f };
+
+    // cache is built while everything is on the map
+    std::vector<TestUnit*> cache{ &despawned, &teleported, &stays, &tooFar };
+
+    // then, later in the same tick
+    despawned.InWorld = false;
+    teleported.Map = &otherMap;
+
+    std::vector<TestUnit*> visited;
+    NPCBots::VisitCachedNearbyUnits(cache, &bot, &bot, 20.0f, [&](TestUnit* u)
+    {
+        visited.push_back(u);
+        return true;
+    });
+
+    REQUIRE(visited == std::vector<TestUnit*>{ &stays });
+}
+
+TEST_CASE("Visiting cached units stops when the visitor returns false", "[NpcBots]")
+{
+    TestMap map;
+    TestUnit bot{ &map, 0.0f };
+    TestUnit first{ &map, 1.0f };
+    TestUnit second{ &map, 2.0f };
+    std::vector<TestUnit*> cache{ &first, &second };
+
+    std::vector<TestUnit*> visited;
+    NPCBots::VisitCachedNearbyUnits(cache, &bot, &bot, 20.0f, [&](TestUnit* u)
+    {
+        visited.push_back(u);
+        return false;
+    });
+
+    REQUIRE(visited == std::vector<TestUnit*>{ &first });
+}
@@ -0,0 +1,106 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "LoaderGraph.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Loaders run after their dependencies", "[LoaderGraph]")
+{
+    std::mutex lock;
+    std::vector<LoaderGraph::LoaderId> order;
+
+    LoaderGraph graph;
+    auto record = [&](LoaderGraph::LoaderId id)
+    {
+        return [&, id]()
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            order.push_back(id);
+        };
+    };
+
+    LoaderGraph::LoaderId a = graph.Add("a", record(0));
+    LoaderGraph::LoaderId b = graph.Add("b", record(1));
+    LoaderGraph::LoaderId c = graph.Add("c", record(2), { a });
+    LoaderGraph::LoaderId d = graph.Add("d", record(3), { b, c });
+    graph.Add("e", record(4), { d });
+    graph.Add("f", record(5));
+
+    auto position = [&order](LoaderGraph::LoaderId id)
+    {
+        return std::find(order.begin(), order.end(), id) - order.begin();
+    };
+
+    SECTION("sequential")
+    {
+        graph.Run(1);
+        REQUIRE(order == std::vector<LoaderGraph::LoaderId>{ 0, 1, 2, 3, 4, 5 });
+    }
+
+    SECTION("parallel")
+    {
+        graph.Run(4);
+        REQUIRE(order.size() == 6);
+        REQUIRE(position(a) < position(c));
+        REQUIRE(position(b) < position(d));
+        REQUIRE(position(c) < position(d));
+        REQUIRE(position(d) < position(4));
+    }
+}
+
+TEST_CASE("Independent loaders run concurrently", "[LoaderGraph]")
+{
+    std::atomic<int> started = 0;
+    auto waitForOthers = [&started]()
+    {
+        ++started;
+        while (started < 3)
+            std::this_thread::yield();
+    };
+
+    LoaderGraph graph;
+    graph.Add("a", waitForOthers);
+    graph.Add("b", waitForOthers);
+    graph.Add("c", waitForOthers);
+
+    // would never finish if the loaders ran one after another
+    graph.Run(3);
+    REQUIRE(started == 3);
+}
+
+TEST_CASE("Critical path follows the latest finishing dependencies", "[LoaderGraph]")
+{
+    auto sleepFor = [](Milliseconds duration) { return [duration]() { std::this_thread::sleep_for(duration); }; };
+
+    LoaderGraph graph;
+    LoaderGraph::LoaderId slow = graph.Add("slow", sleepFor(60ms));
+    LoaderGraph::LoaderId fast = graph.Add("fast", sleepFor(1ms));
+    LoaderGraph::LoaderId join = graph.Add("join", sleepFor(1ms), { slow, fast });
+    graph.Add("unrelated", sleepFor(1ms));
+
+    graph.Run(4);
+
+    REQUIRE(graph.GetCriticalPath() == std::vector<LoaderGraph::LoaderId>{ slow, join });
+    REQUIRE(graph.GetDuration(slow) >= 60ms);
+    REQUIRE(graph.GetTotalDuration() >= graph.GetDuration(slow) + graph.GetDuration(join));
+}
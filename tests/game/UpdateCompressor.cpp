@@ -0,0 +1,174 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "ByteBuffer.h"
+#include "UpdateCompressor.h"
+#include "UpdateData.h"
+#include <chrono>
+#include <random>
+#include <vector>
+#include <zlib.h>
+
+namespace
+{
+    // roughly what a creature create block looks like: header, movement block and a sparse values block
+    std::vector<uint8> MakeCreateObjectPayload(uint32 blockCount)
+    {
+        std::mt19937 rng(blockCount);
+        std::uniform_real_distribution<float> coord(-5000.0f, 5000.0f);
+        std::uniform_int_distribution<uint32> entry(1, 40000);
+
+        ByteBuffer buf;
+        buf << uint32(blockCount);
+        for (uint32 i = 0; i < blockCount; ++i)
+        {
+            buf << uint8(UPDATETYPE_CREATE_OBJECT);
+            buf << uint8(0x3F) << uint32(0x1000 + i) << uint8(0x30) << uint8(0xF1) << uint8(0x30) << uint8(0x00);
+            buf << uint8(3);
+
+            // movement
+            buf << uint16(UPDATEFLAG_LIVING | UPDATEFLAG_HAS_TARGET);
+            buf << uint32(0) << uint16(0) << uint32(i * 100);
+            buf << coord(rng) << coord(rng) << coord(rng) << float(i % 6);
+            buf << uint32(0);
+            for (float speed : { 2.5f, 7.0f, 4.5f, 4.72f, 2.5f, 7.0f, 4.5f, 3.14f, 3.14f })
+                buf << speed;
+
+            // values: mask followed by set fields
+            buf << uint8(5);
+            for (uint32 mask : { 0x0000001Fu, 0x00F000C0u, 0x0000FF00u, 0x00030000u, 0x0000000Fu })
+                buf << mask;
+            for (uint32 field = 0; field < 26; ++field)
+                buf << uint32(field < 4 ? entry(rng) : field * 3 % 7);
+        }
+
+        return std::vector<uint8>(buf.contents(), buf.contents() + buf.size());
+    }
+
+    std::vector<uint8> Inflate(std::vector<uint8> const& compressed, std::size_t size)
+    {
+        std::vector<uint8> result(size);
+        uLongf resultSize = uLongf(size);
+        if (uncompress(result.data(), &resultSize, compressed.data(), uLong(compressed.size())) != Z_OK)
+            result.clear();
+        else
+            result.resize(resultSize);
+        return result;
+    }
+
+    std::vector<uint8> Deflate(std::vector<uint8> const& payload, int level)
+    {
+        std::vector<uint8> result(compressBound(uLong(payload.size())));
+        uint32 size = UpdateCompressor::Compress(result.data(), uint32(result.size()), payload.data(), uint32(payload.size()), level);
+        result.resize(size);
+        return result;
+    }
+}
+
+TEST_CASE("UpdateCompressor: payloads inflate back", "[UpdateCompressor]")
+{
+    for (uint32 blockCount : { 2u, 30u, 600u })
+    {
+        std::vector<uint8> payload = MakeCreateObjectPayload(blockCount);
+        INFO("payload size " << payload.size());
+
+        // the stream is reused between calls, also with a changing level
+        for (int level : { Z_BEST_SPEED, 6, Z_BEST_SPEED, Z_BEST_COMPRESSION })
+        {
+            std::vector<uint8> compressed = Deflate(payload, level);
+            REQUIRE(!compressed.empty());
+            REQUIRE(compressed.size() < payload.size());
+            REQUIRE(Inflate(compressed, payload.size()) == payload);
+        }
+    }
+}
+
+TEST_CASE("UpdateCompressor: levels alternating across the large payload size", "[UpdateCompressor]")
+{
+    std::vector<uint8> small = MakeCreateObjectPayload(30);
+    std::vector<uint8> large = MakeCreateObjectPayload(600);
+    REQUIRE(small.size() < UpdateCompressor::LARGE_PAYLOAD_SIZE);
+    REQUIRE(large.size() >= UpdateCompressor::LARGE_PAYLOAD_SIZE);
+
+    // every payload goes to its own output buffer, a level change must not touch the previous one
+    std::vector<std::vector<uint8>> compressed;
+    std::vector<std::vector<uint8> const*> payloads;
+    for (uint32 i = 0; i < 6; ++i)
+    {
+        std::vector<uint8> const& payload = (i % 2) ? large : small;
+        compressed.push_back(Deflate(payload, UpdateCompressor::SelectLevel(payload.size(), 6)));
+        payloads.push_back(&payload);
+    }
+
+    for (std::size_t i = 0; i < compressed.size(); ++i)
+    {
+        INFO("payload " << i);
+        REQUIRE(!compressed[i].empty());
+        REQUIRE(Inflate(compressed[i], payloads[i]->size()) == *payloads[i]);
+    }
+}
+
+TEST_CASE("UpdateCompressor: fails on too small output buffer", "[UpdateCompressor]")
+{
+    std::vector<uint8> payload = MakeCreateObjectPayload(30);
+    std::vector<uint8> tooSmall(16);
+    REQUIRE(UpdateCompressor::Compress(tooSmall.data(), uint32(tooSmall.size()), payload.data(), uint32(payload.size()), Z_BEST_SPEED) == 0);
+
+    // next payload must not be affected by the failed one
+    std::vector<uint8> compressed = Deflate(payload, Z_BEST_SPEED);
+    REQUIRE(Inflate(compressed, payload.size()) == payload);
+}
+
+TEST_CASE("UpdateCompressor: level selection", "[UpdateCompressor]")
+{
+    REQUIRE(UpdateCompressor::SelectLevel(200, 6) == 6);
+    REQUIRE(UpdateCompressor::SelectLevel(UpdateCompressor::LARGE_PAYLOAD_SIZE - 1, 6) == 6);
+    REQUIRE(UpdateCompressor::SelectLevel(UpdateCompressor::LARGE_PAYLOAD_SIZE, 6) == Z_BEST_SPEED);
+    REQUIRE(UpdateCompressor::SelectLevel(UpdateCompressor::LARGE_PAYLOAD_SIZE, Z_BEST_SPEED) == Z_BEST_SPEED);
+}
+
+// not run by default, use "[benchmark]" tag to run
+TEST_CASE("UpdateCompressor: reused stream against per packet zlib state", "[.][benchmark][UpdateCompressor]")
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr uint32 Iterations = 5000;
+
+    for (uint32 blockCount : { 2u, 30u })
+    {
+        std::vector<uint8> payload = MakeCreateObjectPayload(blockCount);
+        std::vector<uint8> out(compressBound(uLong(payload.size())));
+
+        Clock::time_point start = Clock::now();
+        for (uint32 i = 0; i < Iterations; ++i)
+            REQUIRE(UpdateCompressor::Compress(out.data(), uint32(out.size()), payload.data(), uint32(payload.size()), Z_BEST_SPEED) != 0);
+        Clock::duration reused = Clock::now() - start;
+
+        start = Clock::now();
+        for (uint32 i = 0; i < Iterations; ++i)
+        {
+            uLongf outSize = uLongf(out.size());
+            REQUIRE(compress2(out.data(), &outSize, payload.data(), uLong(payload.size()), Z_BEST_SPEED) == Z_OK);
+        }
+        Clock::duration perPacket = Clock::now() - start;
+
+        WARN(payload.size() << " bytes x " << Iterations << ": reused stream "
+            << std::chrono::duration_cast<std::chrono::microseconds>(reused).count() << " us, per packet state "
+            << std::chrono::duration_cast<std::chrono::microseconds>(perPacket).count() << " us");
+    }
+}